@@ -0,0 +1,51 @@
+// bench.hpp
+// Timing and input generation shared by the benchmarks.
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+
+namespace bench {
+    // Runs fn repeats times and returns the fastest run in milliseconds.
+    inline double bestOf(int repeats, const std::function<void()>& fn) {
+        double best = 0;
+        for (int run = 0; run < repeats; run++) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            best = (run == 0) ? elapsed : std::min(best, elapsed);
+        }
+        return best;
+    }
+
+    // CFG text of at least minBytes, made of sections holding keysPerSection values and a comment.
+    inline std::string makeCfg(std::size_t minBytes, int keysPerSection = 50) {
+        std::string text;
+        for (int section = 0; text.size() < minBytes; section++) {
+            text += "[section" + std::to_string(section) + "]\n# generated\n";
+            for (int key = 0; key < keysPerSection; key++) {
+                text += "key" + std::to_string(key) + " = value_" + std::to_string(section) + "_" + std::to_string(key) + "\n";
+            }
+            text += "\n";
+        }
+        return text;
+    }
+
+    // INI text of at least minBytes.
+    inline std::string makeIni(std::size_t minBytes) {
+        std::string text;
+        for (int key = 0; text.size() < minBytes; key++) {
+            text += "key" + std::to_string(key) + " = " + std::to_string(key * 7) + "\n";
+        }
+        return text;
+    }
+
+    inline void writeFile(const std::string& path, const std::string& text) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    inline double megabytesPerSecond(std::size_t bytes, double milliseconds) { return bytes / 1e6 / (milliseconds / 1e3); }
+}
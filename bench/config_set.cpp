@@ -0,0 +1,57 @@
+// config_set.cpp
+// Loads a generated conf.d directory of 2000 small files (or the count given as first argument), half INI and half CFG,
+// one constructor after another and through ConfigSet with 1 to N threads, N being the second argument or the number of hardware threads.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::size_t fileCount = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    unsigned maxThreads = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : std::max(1u, std::thread::hardware_concurrency());
+
+    const std::string directory = "bench_conf.d";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+    for (std::size_t file = 0; file < fileCount; file++) {
+        std::string name = directory + "/" + std::to_string(10000 + file);
+        if (file % 2 == 0) {
+            bench::writeFile(name + ".ini", bench::makeIni(1000));
+        }
+        else {
+            bench::writeFile(name + ".cfg", bench::makeCfg(2000, 10));
+        }
+    }
+
+    // Parsers are kept until all files are loaded, as ConfigSet keeps them.
+    double serialTime = bench::bestOf(3, [&] {
+        std::vector<std::unique_ptr<ConfigParser::IniParser>> iniFiles;
+        std::vector<std::unique_ptr<ConfigParser::CfgParser>> cfgFiles;
+        for (auto& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.path().extension() == ".ini") {
+                iniFiles.push_back(std::make_unique<ConfigParser::IniParser>(entry.path().string()));
+            }
+            else {
+                cfgFiles.push_back(std::make_unique<ConfigParser::CfgParser>(entry.path().string()));
+            }
+        }
+    });
+    std::printf("%zu files, one parser after another: %.1f ms\n", fileCount, serialTime);
+
+    std::printf("%8s %12s %12s %10s\n", "threads", "ms", "files/s", "speedup");
+    for (unsigned threads = 1; threads <= maxThreads; threads++) {
+        double time = bench::bestOf(3, [&] {
+            ConfigParser::ConfigSet set(threads);
+            if (set.load(directory) != ConfigParser::ConfigError::NO_ERROR || set.files().size() != fileCount) {
+                std::abort();
+            }
+        });
+        std::printf("%8u %12.1f %12.0f %9.2fx\n", threads, time, fileCount / (time / 1e3), serialTime / time);
+    }
+    std::filesystem::remove_all(directory);
+    return 0;
+}
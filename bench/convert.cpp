@@ -0,0 +1,72 @@
+// convert.cpp
+// Conversions per second between text and numbers. "before" repeats what ConfigValue used to do, std::stoi/std::stod
+// on a std::string and a std::stringstream per formatted value; "after" goes through ConfigValue, built on std::from_chars/std::to_chars.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+int main() {
+    const std::size_t count = 1000000;
+    std::vector<std::string> integers, decimals;
+    std::vector<double> numbers;
+    for (std::size_t index = 0; index < count; index++) {
+        integers.push_back(std::to_string(static_cast<int>(index * 2654435761u % 2000000) - 1000000));
+        numbers.push_back(static_cast<double>(index) / 7.0 - 50000.0);
+        std::ostringstream stream;
+        stream.precision(17);
+        stream << numbers.back();
+        decimals.push_back(stream.str());
+    }
+    long long sum = 0;
+    double total = 0;
+    std::size_t length = 0;
+
+    double intBefore = bench::bestOf(3, [&] {
+        for (auto& text : integers) {
+            sum += std::stoi(text);
+        }
+    });
+    double intAfter = bench::bestOf(3, [&] {
+        for (auto& text : integers) {
+            sum += static_cast<int>(ConfigParser::ConfigValue(text));
+        }
+    });
+    double doubleBefore = bench::bestOf(3, [&] {
+        for (auto& text : decimals) {
+            total += std::stod(text);
+        }
+    });
+    double doubleAfter = bench::bestOf(3, [&] {
+        for (auto& text : decimals) {
+            total += static_cast<double>(ConfigParser::ConfigValue(text));
+        }
+    });
+    double formatBefore = bench::bestOf(3, [&] {
+        for (double number : numbers) {
+            std::stringstream stream;
+            stream << number;
+            length += stream.str().size();
+        }
+    });
+    double formatAfter = bench::bestOf(3, [&] {
+        std::string output;
+        for (double number : numbers) {
+            output.clear();
+            ConfigParser::ConfigValue(number).appendTo(output);
+            length += output.size();
+        }
+    });
+    if (sum == 0 && total == 0 && length == 0) {
+        std::abort();
+    }
+
+    auto perSecond = [count](double milliseconds) { return count / (milliseconds / 1e3) / 1e6; };
+    std::printf("%16s %18s %18s\n", "", "before Mconv/s", "after Mconv/s");
+    std::printf("%16s %18.1f %18.1f\n", "text to int", perSecond(intBefore), perSecond(intAfter));
+    std::printf("%16s %18.1f %18.1f\n", "text to double", perSecond(doubleBefore), perSecond(doubleAfter));
+    std::printf("%16s %18.1f %18.1f\n", "double to text", perSecond(formatBefore), perSecond(formatAfter));
+    return 0;
+}
@@ -0,0 +1,49 @@
+// lexer.cpp
+// Throughput of the Lexer alone on a generated 64 MB CFG buffer (or the size in MB given as argument), without building a document.
+// Reports bytes per nanosecond, and bytes per cycle of the time stamp counter on x86.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+static unsigned long long cycles() { return __rdtsc(); }
+#define HAS_CYCLES 1
+#endif
+
+int main(int argc, char* argv[]) {
+    std::size_t megabytes = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 64;
+    std::string text = bench::makeCfg(megabytes * 1000 * 1000);
+
+    std::size_t tokens = 0;
+#ifdef HAS_CYCLES
+    unsigned long long bestCycles = 0;
+#endif
+    double time = bench::bestOf(5, [&] {
+#ifdef HAS_CYCLES
+        unsigned long long start = cycles();
+#endif
+        ConfigParser::Lexer lexer(text);
+        ConfigParser::ConfigToken token;
+        tokens = 0;
+        while (lexer.next(token)) {
+            tokens++;
+        }
+#ifdef HAS_CYCLES
+        unsigned long long elapsed = cycles() - start;
+        bestCycles = (bestCycles == 0) ? elapsed : std::min(bestCycles, elapsed);
+#endif
+    });
+
+    std::printf("%zu bytes, %zu tokens in %.1f ms: %.2f bytes/ns", text.size(), tokens, time, text.size() / (time * 1e6));
+#ifdef HAS_CYCLES
+    std::printf(", %.2f bytes/cycle", static_cast<double>(text.size()) / bestCycles);
+#endif
+    std::printf("\n");
+    return 0;
+}
@@ -0,0 +1,70 @@
+// load_file.cpp
+// Loads generated files of 1 MB and 100 MB (or the sizes in MB given as arguments, e.g. 1 100 1024) through IniParser
+// and CfgParser, once reading the file into a buffer and once through a memory mapping (setMapped()).
+// The getline column only reads the same file line by line with std::getline, as a floor for line based I/O. It is not the
+// parser that used std::fstream before, which is gone from the tree, so this is not a before/after comparison.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+template<typename parser_type>
+static double loadTime(const char* path, bool mapped, int repeats) {
+    return bench::bestOf(repeats, [path, mapped] {
+        parser_type parser;
+        parser.setMapped(mapped);
+        parser.load(path);
+        if (parser.getError() != ConfigParser::ConfigError::NO_ERROR) {
+            std::abort();
+        }
+    });
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> sizes;
+    for (int arg = 1; arg < argc; arg++) {
+        sizes.push_back(std::strtoull(argv[arg], nullptr, 10));
+    }
+    if (sizes.empty()) {
+        sizes = { 1, 100 };
+    }
+
+    std::printf("%6s %14s %14s %14s %14s %14s\n", "MB", "getline MB/s", "INI read", "INI mapped", "CFG read", "CFG mapped");
+    for (std::size_t megabytes : sizes) {
+        std::size_t minBytes = megabytes * 1000 * 1000;
+        int repeats = (megabytes < 100) ? 10 : 3;
+
+        std::string ini = bench::makeIni(minBytes);
+        bench::writeFile("bench_load.ini", ini);
+        std::size_t iniSize = ini.size();
+        ini = std::string();
+        double getlineTime = bench::bestOf(repeats, [] {
+            std::ifstream file("bench_load.ini");
+            std::string line;
+            std::size_t lines = 0;
+            while (std::getline(file, line)) {
+                lines++;
+            }
+            if (lines == 0) {
+                std::abort();
+            }
+        });
+        double iniRead = loadTime<ConfigParser::IniParser>("bench_load.ini", false, repeats);
+        double iniMapped = loadTime<ConfigParser::IniParser>("bench_load.ini", true, repeats);
+
+        std::string cfg = bench::makeCfg(minBytes);
+        bench::writeFile("bench_load.cfg", cfg);
+        std::size_t cfgSize = cfg.size();
+        cfg = std::string();
+        double cfgRead = loadTime<ConfigParser::CfgParser>("bench_load.cfg", false, repeats);
+        double cfgMapped = loadTime<ConfigParser::CfgParser>("bench_load.cfg", true, repeats);
+
+        std::printf("%6zu %14.0f %14.0f %14.0f %14.0f %14.0f\n", megabytes, bench::megabytesPerSecond(iniSize, getlineTime),
+            bench::megabytesPerSecond(iniSize, iniRead), bench::megabytesPerSecond(iniSize, iniMapped),
+            bench::megabytesPerSecond(cfgSize, cfgRead), bench::megabytesPerSecond(cfgSize, cfgMapped));
+    }
+    std::remove("bench_load.ini");
+    std::remove("bench_load.cfg");
+    return 0;
+}
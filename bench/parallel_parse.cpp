@@ -0,0 +1,34 @@
+// parallel_parse.cpp
+// Loads a generated 100 MB CFG file (or the size in MB given as first argument) with 1 to N parser threads,
+// N being the second argument or the number of hardware threads.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+int main(int argc, char* argv[]) {
+    std::size_t megabytes = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100;
+    unsigned maxThreads = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::string text = bench::makeCfg(megabytes * 1000 * 1000);
+    bench::writeFile("bench_parallel.cfg", text);
+    std::size_t size = text.size();
+    text = std::string();
+
+    std::printf("%8s %12s %12s %10s\n", "threads", "ms", "MB/s", "speedup");
+    double serialTime = 0;
+    for (unsigned threads = 1; threads <= maxThreads; threads++) {
+        double time = bench::bestOf(3, [threads] {
+            ConfigParser::CfgParser parser;
+            parser.load("bench_parallel.cfg", threads);
+            if (parser.getError() != ConfigParser::ConfigError::NO_ERROR) {
+                std::abort();
+            }
+        });
+        serialTime = (threads == 1) ? time : serialTime;
+        std::printf("%8u %12.1f %12.0f %9.2fx\n", threads, time, bench::megabytesPerSecond(size, time), serialTime / time);
+    }
+    std::remove("bench_parallel.cfg");
+    return 0;
+}
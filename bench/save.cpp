@@ -0,0 +1,65 @@
+// save.cpp
+// Saves documents of 100k and 1M keys built in code, so every line is formatted, next to writing the same lines
+// through std::ofstream with std::endl, the way save() used to write them.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+int main() {
+    std::printf("%10s %6s %16s %16s %12s\n", "keys", "", "std::endl ms", "save() ms", "MB/s");
+    for (int keyCount : { 100000, 1000000 }) {
+        ConfigParser::IniParser ini;
+        ConfigParser::CfgParser cfg;
+        for (int key = 0; key < keyCount; key++) {
+            ini["key" + std::to_string(key)] = key;
+            if (key % 100 == 0) {
+                cfg.addSection("section" + std::to_string(key / 100));
+            }
+            cfg["section" + std::to_string(key / 100)]["key" + std::to_string(key % 100)] = "value_" + std::to_string(key);
+        }
+
+        double iniBefore = bench::bestOf(3, [&] {
+            std::ofstream file("bench_save.ini");
+            for (auto& key : ini) {
+                file << key << " = " << ini.get(key) << std::endl;
+            }
+        });
+        // Every run changes a value, otherwise save() finds the file unchanged and skips the write.
+        int run = 0;
+        double iniAfter = bench::bestOf(3, [&] {
+            ini["key0"] = --run;
+            ini.save("bench_save.ini");
+            if (ini.getError() != ConfigParser::ConfigError::NO_ERROR) {
+                std::abort();
+            }
+        });
+        std::size_t iniSize = ini.saveToString().size();
+        double cfgBefore = bench::bestOf(3, [&] {
+            std::ofstream file("bench_save.cfg");
+            for (auto& sectionName : cfg.sections()) {
+                file << "[" << sectionName << "]" << std::endl;
+                auto& section_ = cfg.section(sectionName);
+                for (auto& key : section_) {
+                    file << key << " = " << section_.get(key) << std::endl;
+                }
+                file << std::endl;
+            }
+        });
+        double cfgAfter = bench::bestOf(3, [&] {
+            cfg["section0"]["key0"] = --run;
+            cfg.save("bench_save.cfg");
+            if (cfg.getError() != ConfigParser::ConfigError::NO_ERROR) {
+                std::abort();
+            }
+        });
+        std::size_t cfgSize = cfg.saveToString().size();
+
+        std::printf("%10d %6s %16.1f %16.1f %12.0f\n", keyCount, "INI", iniBefore, iniAfter, bench::megabytesPerSecond(iniSize, iniAfter));
+        std::printf("%10s %6s %16.1f %16.1f %12.0f\n", "", "CFG", cfgBefore, cfgAfter, bench::megabytesPerSecond(cfgSize, cfgAfter));
+    }
+    std::remove("bench_save.ini");
+    std::remove("bench_save.cfg");
+    return 0;
+}
@@ -0,0 +1,56 @@
+// update_key.cpp
+// Changes a single key of a generated 50 MB CFG and INI file (or the size in MB given as argument) and saves it,
+// next to the cost of copying the file's bytes once, the floor for any save that rewrites the whole file.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::size_t megabytes = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 50;
+    std::string cfgText = bench::makeCfg(megabytes * 1000 * 1000, 100);
+    std::string iniText = bench::makeIni(megabytes * 1000 * 1000);
+    bench::writeFile("bench_update.cfg", cfgText);
+    bench::writeFile("bench_update.ini", iniText);
+
+    double copyTime = bench::bestOf(5, [&] {
+        std::vector<char> copy(cfgText.size());
+        std::memcpy(copy.data(), cfgText.data(), cfgText.size());
+        if (copy.back() != '\n') {
+            std::abort();
+        }
+    });
+    std::printf("%.1f MB CFG, %.1f MB INI, copying the CFG bytes: %.1f ms\n", cfgText.size() / 1e6, iniText.size() / 1e6, copyTime);
+
+    ConfigParser::CfgParser cfg("bench_update.cfg");
+    ConfigParser::IniParser ini("bench_update.ini");
+    int value = 0;
+    double cfgSerialize = bench::bestOf(5, [&] {
+        cfg["section100"]["key50"] = value++;
+        if (cfg.saveToString().empty()) {
+            std::abort();
+        }
+    });
+    double cfgSave = bench::bestOf(5, [&] {
+        cfg["section100"]["key50"] = value++;
+        cfg.save();
+    });
+    double iniSerialize = bench::bestOf(5, [&] {
+        ini["key1000"] = value++;
+        if (ini.saveToString().empty()) {
+            std::abort();
+        }
+    });
+    double iniSave = bench::bestOf(5, [&] {
+        ini["key1000"] = value++;
+        ini.save();
+    });
+    std::printf("%6s %16s %16s\n", "", "serialize ms", "save ms");
+    std::printf("%6s %16.1f %16.1f\n", "CFG", cfgSerialize, cfgSave);
+    std::printf("%6s %16.1f %16.1f\n", "INI", iniSerialize, iniSave);
+    std::remove("bench_update.cfg");
+    std::remove("bench_update.ini");
+    return 0;
+}
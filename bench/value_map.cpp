@@ -0,0 +1,89 @@
+// value_map.cpp
+// Lookup and iteration over a ConfigSection of 10, 1k and 100k keys, next to the std::map plus key vector it replaced,
+// and inserting 200k values of 1 KB, which moves every value when the entries grow.
+#include "ConfigParser.hpp"
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+// The layout ConfigSection used before ValueMap: a node based map for lookups and a vector for the insertion order.
+struct MapSection {
+    std::map<std::string, ConfigParser::ConfigValue> values;
+    std::vector<std::string> keys;
+};
+
+int main() {
+    std::printf("%8s %10s %16s %16s %16s\n", "keys", "", "lookup ns", "keys ns/key", "values ns/key");
+    for (std::size_t keyCount : { 10, 1000, 100000 }) {
+        std::vector<std::string> names;
+        ConfigParser::ConfigSection section;
+        MapSection mapSection;
+        for (std::size_t key = 0; key < keyCount; key++) {
+            names.push_back("key" + std::to_string(key * 7919 % keyCount));
+            section[names.back()] = static_cast<int>(key);
+            mapSection.values.emplace(names.back(), static_cast<int>(key));
+            mapSection.keys.push_back(names.back());
+        }
+        const ConfigParser::ConfigSection& constSection = section;
+        std::size_t lookups = std::max<std::size_t>(keyCount, 1000000);
+        std::size_t rounds = std::max<std::size_t>(1, 1000000 / keyCount);
+        long long sum = 0;
+
+        double sectionLookup = bench::bestOf(5, [&] {
+            for (std::size_t index = 0; index < lookups; index++) {
+                sum += constSection.get(names[index % keyCount]).getOr<int>(0);
+            }
+        });
+        double mapLookup = bench::bestOf(5, [&] {
+            for (std::size_t index = 0; index < lookups; index++) {
+                sum += mapSection.values.find(names[index % keyCount])->second.getOr<int>(0);
+            }
+        });
+        double sectionKeys = bench::bestOf(5, [&] {
+            for (std::size_t round = 0; round < rounds; round++) {
+                for (auto& key : section) {
+                    sum += static_cast<long long>(key.size());
+                }
+            }
+        });
+        double mapKeys = bench::bestOf(5, [&] {
+            for (std::size_t round = 0; round < rounds; round++) {
+                for (auto& key : mapSection.keys) {
+                    sum += static_cast<long long>(key.size());
+                }
+            }
+        });
+        double sectionValues = bench::bestOf(5, [&] {
+            for (std::size_t round = 0; round < rounds; round++) {
+                for (auto& key : section) {
+                    sum += constSection.get(key).getOr<int>(0);
+                }
+            }
+        });
+        double mapValues = bench::bestOf(5, [&] {
+            for (std::size_t round = 0; round < rounds; round++) {
+                for (auto& key : mapSection.keys) {
+                    sum += mapSection.values.find(key)->second.getOr<int>(0);
+                }
+            }
+        });
+        if (sum == 0) {
+            std::abort();
+        }
+        double iterated = static_cast<double>(rounds * keyCount);
+        std::printf("%8zu %10s %16.1f %16.2f %16.1f\n", keyCount, "ValueMap", sectionLookup * 1e6 / lookups, sectionKeys * 1e6 / iterated, sectionValues * 1e6 / iterated);
+        std::printf("%8s %10s %16.1f %16.2f %16.1f\n", "", "std::map", mapLookup * 1e6 / lookups, mapKeys * 1e6 / iterated, mapValues * 1e6 / iterated);
+    }
+
+    std::string largeValue(1024, 'v');
+    double insertTime = bench::bestOf(3, [&] {
+        ConfigParser::ConfigSection section;
+        for (int key = 0; key < 200000; key++) {
+            section["key" + std::to_string(key)] = largeValue;
+        }
+    });
+    std::printf("inserting 200000 values of 1 KB: %.1f ms\n", insertTime);
+    return 0;
+}
@@ -20,15 +20,64 @@
 #include <algorithm>
 #include <utility>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <fstream>
 #include <type_traits>
+#include <array>
 #include <typeinfo>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <thread>
+#include <future>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <optional>
+#include <variant>
+#include <random>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
+#include <bit>
+// x86-64 builds scan lines with SSE2, which every x86-64 CPU has, and switch to AVX2 when the CPU supports it.
+#if defined(__x86_64__) || defined(_M_X64)
+#define CONFIGPARSER_X86_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
 #include "strutil.h"
 
+// Errors that would throw abort instead when exceptions are disabled (-fno-exceptions), probe with tryGet(), getOr(), exists() or hasSection() first.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define CONFIGPARSER_THROW(exception) throw exception
+#else
+#define CONFIGPARSER_THROW(exception) std::abort()
+#endif
+
 
 /**
 * @brief ConfigParser namespace
@@ -39,28 +88,167 @@ namespace ConfigParser {
 	class ConfigValue;
 	class ConfigSection;
 	struct ConfigLine;
-	typedef std::unordered_map<std::string, ConfigSection> SectionMap;
+
+	/**
+	* @struct StringHash struct
+	* @brief Transparent string hash, lets unordered maps keyed by std::string be searched with a std::string_view or a literal without building a temporary.
+	*/
+	struct StringHash {
+		using is_transparent = void;
+		std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+	};
+
+	typedef std::unordered_map<std::string, ConfigSection, StringHash, std::equal_to<>> SectionMap;
 	typedef std::vector<ConfigLine> LineVector;
-	typedef std::map<std::string, ConfigValue> ValueMap;
 	typedef std::vector<std::string> StringVector;
 	using KeysIter = typename StringVector::iterator;
 	using ConstKeysIter = typename StringVector::const_iterator;
+	typedef std::function<void(std::function<void()>)> Executor; //< Runs a task, usually on another thread. Used by the asynchronous load and save functions.
 	using namespace strutil;
 
-	template<typename element_t>
-	static inline int find(const std::vector<element_t>& vectorContainer, const element_t& value) {
+	template<typename element_t, typename value_t = element_t>
+	static inline int find(const std::vector<element_t>& vectorContainer, const value_t& value) {
 		auto iter = std::find(vectorContainer.begin(), vectorContainer.end(), value);
 		return !(iter == vectorContainer.end()) ? static_cast<int> (std::distance(vectorContainer.begin(), iter)) : -1;
 	}
 
-	template<typename element_t>
-	static inline void removeElement(std::vector<element_t>& vectorContainer, const element_t& value) {
-		int index = find<element_t>(vectorContainer, value);
+	template<typename element_t, typename value_t = element_t>
+	static inline void removeElement(std::vector<element_t>& vectorContainer, const value_t& value) {
+		int index = find(vectorContainer, value);
 		if (index != -1) {
 			vectorContainer.erase(vectorContainer.begin() + index);
 		}
 	}
 
+	/**
+	* @enum CharClass enum
+	* @brief Character classes recognised by the line classifier.
+	*/
+	enum CharClass : unsigned char {
+		CHAR_OTHER,
+		CHAR_SPACE,
+		CHAR_NEWLINE,
+		CHAR_EQUALS,
+		CHAR_COMMENT,
+		CHAR_SECTION_OPEN,
+		CHAR_SECTION_CLOSE,
+		CHAR_CLASS_COUNT
+	};
+
+	// Lookup table mapping every byte to its CharClass, so the lexer classifies input with one load per character.
+	inline constexpr std::array<unsigned char, 256> charClasses = [] {
+		std::array<unsigned char, 256> table{};
+		for (unsigned char c : std::string_view(" \t\r\v\f")) {
+			table[c] = CHAR_SPACE;
+		}
+		table['\n'] = CHAR_NEWLINE;
+		table['='] = CHAR_EQUALS;
+		table['#'] = CHAR_COMMENT;
+		table['['] = CHAR_SECTION_OPEN;
+		table[']'] = CHAR_SECTION_CLOSE;
+		return table;
+	}();
+
+	static inline CharClass charClass(char c) { return static_cast<CharClass>(charClasses[static_cast<unsigned char>(c)]); }
+	static inline bool isSpace(char c) { return charClass(c) == CHAR_SPACE || charClass(c) == CHAR_NEWLINE; }
+
+	/**
+	* @brief Offset of the first byte equal to first or second at or after offset, or the buffer size. One byte at a time.
+	*/
+	static inline std::size_t findEitherScalar(std::string_view buffer, std::size_t offset, char first, char second) {
+		while (offset < buffer.size() && buffer[offset] != first && buffer[offset] != second) {
+			offset++;
+		}
+		return offset;
+	}
+
+#ifdef CONFIGPARSER_X86_SIMD
+	/**
+	* @brief findEitherScalar() comparing 16 bytes at a time with SSE2.
+	*/
+	static inline std::size_t findEitherSse2(std::string_view buffer, std::size_t offset, char first, char second) {
+		const __m128i firstBytes = _mm_set1_epi8(first), secondBytes = _mm_set1_epi8(second);
+		for (; offset + 16 <= buffer.size(); offset += 16) {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer.data() + offset));
+			unsigned matches = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, firstBytes), _mm_cmpeq_epi8(block, secondBytes))));
+			if (matches != 0) {
+				return offset + std::countr_zero(matches);
+			}
+		}
+		return findEitherScalar(buffer, offset, first, second);
+	}
+
+	/**
+	* @brief findEitherScalar() comparing 32 bytes at a time with AVX2. Only call it when hasAvx2() is true.
+	*/
+#if defined(__GNUC__) || defined(__clang__)
+	__attribute__((target("avx2")))
+#endif
+	static inline std::size_t findEitherAvx2(std::string_view buffer, std::size_t offset, char first, char second) {
+		const __m256i firstBytes = _mm256_set1_epi8(first), secondBytes = _mm256_set1_epi8(second);
+		for (; offset + 32 <= buffer.size(); offset += 32) {
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer.data() + offset));
+			unsigned matches = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, firstBytes), _mm256_cmpeq_epi8(block, secondBytes))));
+			if (matches != 0) {
+				return offset + std::countr_zero(matches);
+			}
+		}
+		return findEitherSse2(buffer, offset, first, second);
+	}
+
+	/**
+	* @brief Checks that the CPU has AVX2 and the operating system saves its registers.
+	*/
+	static inline bool hasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 1);
+		bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+		__cpuidex(info, 7, 0);
+		return osSavesAvx && (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	/**
+	* @brief Offset of the first byte equal to first or second at or after offset, or the buffer size.
+	* Uses the widest vector scan the CPU supports, checked once per program.
+	*/
+	static inline std::size_t findEither(std::string_view buffer, std::size_t offset, char first, char second) {
+#ifdef CONFIGPARSER_X86_SIMD
+		static const bool avx2 = hasAvx2();
+		return avx2 ? findEitherAvx2(buffer, offset, first, second) : findEitherSse2(buffer, offset, first, second);
+#else
+		return findEitherScalar(buffer, offset, first, second);
+#endif
+	}
+
+	/**
+	* @brief Trims white spaces from both sides of a string view without copying it.
+	*/
+	static inline std::string_view trimView(std::string_view str) {
+		while (!str.empty() && isSpace(str.front())) {
+			str.remove_prefix(1);
+		}
+		while (!str.empty() && isSpace(str.back())) {
+			str.remove_suffix(1);
+		}
+		return str;
+	}
+
+	/**
+	* @brief 64 bit FNV-1a hash of a byte range, chainable through the seed.
+	*/
+	static inline std::uint64_t hashBytes(std::string_view bytes, std::uint64_t hash = 14695981039346656037ull) {
+		for (unsigned char c : bytes) {
+			hash ^= c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
 	/**
 * @enum ConfigError Enum class
 	* @brief Defined error types used for file error checking.
@@ -69,721 +257,3485 @@ namespace ConfigParser {
 		FILE_NOT_FOUND,
 		FILE_OPEN_ERROR,
 		FILE_READ_ERROR,
+		FILE_WRITE_ERROR,
+		FILE_FORMAT_ERROR,
+		FILE_OUTDATED,
 		NO_ERROR
 	};
 
 	/**
-* @enum ConfigType enum
-	* @brief Config data types.
+	* @brief Reads a whole file into a buffer with one read call.
 	*/
-	enum class ConfigType {
-		CONFIG_EMPTY_LINE,
-		CONFIG_COMMENT,
-		CONFIG_SECTION,
-		CONFIG_VALUE
-	};
+	static inline ConfigError readFileBuffer(const std::string& filePath, std::string& buffer) {
+		std::error_code error;
+		if (!std::filesystem::exists(filePath, error)) {
+			return ConfigError::FILE_NOT_FOUND;
+		}
+		std::ifstream stream(filePath, std::ios::in | std::ios::binary);
+		if (!stream.is_open()) {
+			return ConfigError::FILE_OPEN_ERROR;
+		}
+		std::uintmax_t size = std::filesystem::file_size(filePath, error);
+		if (error) {
+			return ConfigError::FILE_READ_ERROR;
+		}
+		buffer.resize(static_cast<std::size_t>(size));
+		stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		return (static_cast<std::size_t>(stream.gcount()) == buffer.size()) ? ConfigError::NO_ERROR : ConfigError::FILE_READ_ERROR;
+	}
+
+#if defined(_WIN32)
+	static inline int createFile(const std::string& filePath) { return _open(filePath.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE); } //< Creates a new file for writing, returns a negative handle on failure or if the file exists.
 
 	/**
-	* @struct ConfigLine struct
-	* @brief Stores config data for reading/writing config files.
+	* @brief Writes the whole buffer to a file handle.
 	*/
-	struct ConfigLine {
-		ConfigType type;
-		std::string content;
-	};
+	static inline bool writeHandle(int handle, std::string_view buffer) {
+		bool success = true;
+		for (std::size_t written = 0; success && written < buffer.size();) {
+			int count = _write(handle, buffer.data() + written, static_cast<unsigned>(std::min<std::size_t>(buffer.size() - written, INT_MAX)));
+			success = count > 0;
+			written += success ? static_cast<std::size_t>(count) : 0;
+		}
+		return success;
+	}
 
 	/**
-	* @class ConfigValue
-	* @brief Base class for managing value data, handles different DataTypes and uses std::string to store them.
+	* @brief Closes a file handle, flushing it to the disk first when sync is set.
 	*/
-	class ConfigValue {
-	private:
-		std::string data;
+	static inline bool closeHandle(int handle, bool sync) {
+		bool success = !sync || _commit(handle) == 0;
+		return (_close(handle) == 0) && success;
+	}
 
-	public:
-		ConfigValue(): 
-			data("") {}
-		template<typename value_type>
-		ConfigValue(value_type _data = "") {
-			setData(_data);
-		}
-		~ConfigValue() {}
+	static inline void syncDirectory(const std::filesystem::path&) {} //< Renames are journaled with the directory on Windows.
+#else
+	static inline int createFile(const std::string& filePath) { return ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666); } //< Creates a new file for writing, returns a negative handle on failure or if the file exists.
 
-		template<typename value_type>
-		ConfigValue& operator=(value_type value) {
-			setData(value);
-			return *this;
+	/**
+	* @brief Writes the whole buffer to a file handle.
+	*/
+	static inline bool writeHandle(int handle, std::string_view buffer) {
+		bool success = true;
+		for (std::size_t written = 0; success && written < buffer.size();) {
+			ssize_t count = ::write(handle, buffer.data() + written, buffer.size() - written);
+			if (count < 0 && errno == EINTR) {
+				continue;
+			}
+			success = count > 0;
+			written += success ? static_cast<std::size_t>(count) : 0;
 		}
+		return success;
+	}
 
-		operator std::string() const { return data; }
+	/**
+	* @brief Closes a file handle, flushing it to the disk first when sync is set.
+	*/
+	static inline bool closeHandle(int handle, bool sync) {
+		bool success = !sync || ::fsync(handle) == 0;
+		return (::close(handle) == 0) && success;
+	}
 
-		template<typename value_type>
-		operator value_type() {
-			return getStringValue<value_type>(data);
+	/**
+	* @brief Flushes a directory entry change, such as a rename, to the disk.
+	*/
+	static inline void syncDirectory(const std::filesystem::path& directory) {
+		int handle = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC);
+		if (handle >= 0) {
+			::fsync(handle);
+			::close(handle);
 		}
+	}
+#endif
 
-		friend std::ostream& operator<<(std::ostream& os, const ConfigValue& cv) {
-			os << cv.data;
-			return os;
+	/**
+	* @brief Creates a new file holding buffer and flushes it to the disk before returning. A file that could not be written completely is removed,
+	* an existing file is left alone.
+	*/
+	static inline ConfigError writeSyncedFile(const std::string& filePath, std::string_view buffer) {
+		int handle = createFile(filePath);
+		if (handle < 0) {
+			return ConfigError::FILE_OPEN_ERROR;
 		}
+		bool success = writeHandle(handle, buffer);
+		success = closeHandle(handle, success) && success;
+		if (!success) {
+			std::error_code error;
+			std::filesystem::remove(filePath, error);
+			return ConfigError::FILE_WRITE_ERROR;
+		}
+		return ConfigError::NO_ERROR;
+	}
 
-		template<typename value_type>
-		void setData(value_type value) {
-			data.clear();
-			if constexpr (std::is_same<value_type, int>::value ||
-				std::is_same<value_type, float>::value ||
-				std::is_same<value_type, double>::value) {
-				data = to_string(value);
-			}
-			else if constexpr (std::is_same<value_type, char>::value ||
-				std::is_same<value_type, std::string>::value) {
-				data = value;
-			}
-			else if constexpr (std::is_same<value_type, bool>::value) {
-				data = (value == true) ? "true" : "false";
-			}
-			else if constexpr (std::is_same<value_type, const char*>::value) {
-				data = std::string(value);
-			}
-			else {
-				static_assert("non supported type");
+	/**
+	* @brief Resolves the file a path designates for replacement, following symbolic links.
+	*/
+	static inline std::filesystem::path replacementTarget(const std::string& filePath) {
+		std::error_code error;
+		std::filesystem::path target(filePath);
+		if (std::filesystem::is_symlink(target, error)) {
+			std::filesystem::path resolved = std::filesystem::canonical(target, error);
+			if (!error) {
+				return resolved;
 			}
 		}
-	private:
-		template <typename type>
-		static inline std::string getType(type variable) {
-			return typeid(std::decay_t<decltype(variable)>).name();
-		}
+		return target;
+	}
 
-		static inline std::string typeErrorMsg(const std::string& type) { return "String value is non convertible to type " + type; }
-		template<typename value_t>
-		static inline value_t convertString(const std::string& str);
+	/**
+	* @brief Unique temporary file name next to a target.
+	*/
+	static inline std::filesystem::path temporaryPath(const std::filesystem::path& target) {
+		std::filesystem::path temp = target;
+		temp += "." + std::to_string(std::random_device()()) + ".tmp";
+		return temp;
+	}
 
-		template<>
-		static inline int convertString(const std::string& str) {
-			int value;
-			try {
-				value = std::stoi(str);
-				return value;
-			}
-			catch (...) {
-				throw std::invalid_argument(typeErrorMsg("int"));
-			}
+	/**
+	* @brief Renames a complete temporary file over the target, keeping the target's permissions, and flushes the directory. The temporary file is removed on failure.
+	*/
+	static inline ConfigError replaceFile(const std::filesystem::path& temp, const std::filesystem::path& target) {
+		std::error_code error;
+		auto status = std::filesystem::status(target, error);
+		if (!error) {
+			std::filesystem::permissions(temp, status.permissions(), error);
 		}
-
-		template<>
-		static inline float convertString(const std::string& str) {
-			float value;
-			try {
-				value = std::stof(str);
-				return value;
-			}
-			catch (...) {
-				throw std::invalid_argument(typeErrorMsg("float"));
-			}
+		std::filesystem::rename(temp, target, error);
+		if (error) {
+			std::filesystem::remove(temp, error);
+			return ConfigError::FILE_WRITE_ERROR;
 		}
+		syncDirectory(target.parent_path());
+		return ConfigError::NO_ERROR;
+	}
 
-		template<>
-		static inline double convertString(const std::string& str) {
-			double value;
-			try {
-				value = std::stod(str);
-				return value;
-			}
-			catch (...) {
-				throw std::invalid_argument(typeErrorMsg("double"));
+	/**
+	* @brief Replaces a file with a buffer so that readers and crashes only ever see the old or the new content.
+	*
+	* The buffer is written to a temporary file next to the target, flushed to the disk and renamed over the target, then the directory is flushed.
+	* Nothing is written when the file already holds exactly these bytes. Symbolic links are followed, the file they point to is replaced.
+	*/
+	static inline ConfigError writeFileBuffer(const std::string& filePath, std::string_view buffer) {
+		std::error_code error;
+		std::filesystem::path target = replacementTarget(filePath);
+		std::uintmax_t size = std::filesystem::file_size(target, error);
+		if (!error && size == buffer.size()) {
+			std::string current;
+			if (readFileBuffer(target.string(), current) == ConfigError::NO_ERROR && current == buffer) {
+				return ConfigError::NO_ERROR;
 			}
 		}
 
-		template<>
-		static inline bool convertString(const std::string& str) {
-			if (str == "true" || str == "false") {
-				return (str == "true") ? true : false;
-			}
-			else {
-				throw std::invalid_argument(typeErrorMsg("bool"));
-			}
+		std::filesystem::path temp = temporaryPath(target);
+		ConfigError result = writeSyncedFile(temp.string(), buffer);
+		if (result != ConfigError::NO_ERROR) {
+			return result;
 		}
+		return replaceFile(temp, target);
+	}
+
+	/**
+* @enum ConfigType enum
+	* @brief Config data types.
+	*/
+	enum class ConfigType {
+		CONFIG_EMPTY_LINE,
+		CONFIG_COMMENT,
+		CONFIG_SECTION,
+		CONFIG_VALUE,
+		CONFIG_REMOVED //< Tombstone left in a parser's lines by a removal, never written.
+	};
+
+	/**
+* @enum ChangeType enum
+	* @brief Kinds of changes reported by reload().
+	*/
+	enum class ChangeType {
+		ADDED,
+		REMOVED,
+		MODIFIED
+	};
+
+	/**
+	* @struct ConfigChange struct
+	* @brief A section or key that changed between two loads. An empty key refers to the whole section, an empty section to an INI file.
+	*/
+	struct ConfigChange {
+		ChangeType type;
+		std::string section;
+		std::string key;
+	};
+	typedef std::vector<ConfigChange> ChangeVector;
+
+	/**
+	* @struct ConfigLine struct
+	* @brief Stores config data for reading/writing config files.
+	*/
+	struct ConfigLine {
+		ConfigType type;
+		std::string_view content; //< View into the owning parser's TextArena.
+		std::string_view text; //< Bytes of the line in the loaded file, empty for lines added in code or following a repeated section header.
+	};
+
+	/**
+	* @class TextArena class
+	* @brief Monotonic storage for parser text.
+	* Hands out views that stay valid until clear(), which releases every block in one step.
+	*/
+	class TextArena {
+	public:
+		TextArena(std::size_t _blockSize = 4096) :
+			blockSize(_blockSize), cursor(nullptr), remaining(0) {}
 
-		template<>
-		static inline char convertString(const std::string& str) {
-			if (str.length() == 1) {
-				return str[0];
+		/**
+		* @brief Copies text into the arena.
+		* @return View of the stored copy.
+		*/
+		std::string_view store(std::string_view text) {
+			if (text.empty()) {
+				return std::string_view();
 			}
-			else {
-				throw std::invalid_argument(typeErrorMsg("char"));
+			if (text.size() > remaining) {
+				// Large strings get a block of their own so the current block keeps its free space.
+				if (text.size() > blockSize / 4) {
+					blocks.push_back(std::make_unique<char[]>(text.size()));
+					std::memcpy(blocks.back().get(), text.data(), text.size());
+					return std::string_view(blocks.back().get(), text.size());
+				}
+				blocks.push_back(std::make_unique<char[]>(blockSize));
+				cursor = blocks.back().get();
+				remaining = blockSize;
 			}
+			std::memcpy(cursor, text.data(), text.size());
+			std::string_view stored(cursor, text.size());
+			cursor += text.size();
+			remaining -= text.size();
+			return stored;
 		}
 
-		template<>
-		static inline std::string convertString(const std::string& str) {
-			if (strutil::contains(getType(str), "string")) {
-				return str;
-			}
-			else {
-				throw std::invalid_argument(typeErrorMsg("string"));
-			}
+		/**
+		* @brief Takes ownership of a whole buffer, such as a loaded file, without copying it.
+		* @return View of the adopted buffer.
+		*/
+		std::string_view adopt(std::string&& buffer) {
+			buffers.push_back(std::move(buffer));
+			return buffers.back();
 		}
 
-		template<typename value_t>
-		static value_t getStringValue(const std::string& str) {
-			if constexpr (std::is_same<value_t, int>::value) {
-				return convertString<int>(str);
-			}
-			else if constexpr (std::is_same<value_t, float>::value) {
-				return convertString<float>(str);
-			}
-			else if constexpr (std::is_same<value_t, double>::value) {
-				return convertString<double>(str);
+		/**
+		* @brief Maps a whole file read only and keeps the mapping until clear(). Windows builds read the file into a buffer instead.
+		* The file must not be changed in place while it is mapped, files replaced by rename, as writeFileBuffer() does, are safe.
+		* @param filePath File to map.
+		* @param view Receives the file contents.
+		* @return Error state as readFileBuffer() reports it.
+		*/
+		ConfigError map(const std::string& filePath, std::string_view& view) {
+#if defined(_WIN32)
+			std::string buffer;
+			ConfigError result = readFileBuffer(filePath, buffer);
+			if (result == ConfigError::NO_ERROR) {
+				view = adopt(std::move(buffer));
 			}
-			else if constexpr (std::is_same<value_t, char>::value) {
-				return convertString<char>(str);
+			return result;
+#else
+			int handle = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+			if (handle < 0) {
+				return (errno == ENOENT) ? ConfigError::FILE_NOT_FOUND : ConfigError::FILE_OPEN_ERROR;
 			}
-			else if constexpr (std::is_same<value_t, bool>::value) {
-				return convertString<bool>(str);
+			struct stat status;
+			if (::fstat(handle, &status) != 0 || !S_ISREG(status.st_mode)) {
+				::close(handle);
+				return ConfigError::FILE_READ_ERROR;
 			}
-			else if constexpr (std::is_same<value_t, std::string>::value) {
-				return convertString<std::string>(str);
+			std::size_t size = static_cast<std::size_t>(status.st_size);
+			if (size == 0) {
+				::close(handle);
+				view = std::string_view();
+				return ConfigError::NO_ERROR;
 			}
-			else {
-				static_assert("unsupported conversion type");
+			int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+			flags |= MAP_POPULATE; // The whole file is parsed right away, fault all pages in with one call.
+#endif
+			void* address = ::mmap(nullptr, size, PROT_READ, flags, handle, 0);
+			::close(handle);
+			if (address == MAP_FAILED) {
+				return ConfigError::FILE_READ_ERROR;
 			}
+			mappings.emplace_back(static_cast<char*>(address), Unmap{ size });
+			view = std::string_view(mappings.back().get(), size);
+			return ConfigError::NO_ERROR;
+#endif
 		}
 
+		/**
+		* @brief Releases all stored text. Views handed out before are invalidated.
+		*/
+		void clear() {
+			blocks.clear();
+			buffers.clear();
+#if !defined(_WIN32)
+			mappings.clear();
+#endif
+			cursor = nullptr;
+			remaining = 0;
+		}
 
+	private:
+		std::size_t blockSize;
+		char* cursor;
+		std::size_t remaining;
+		std::vector<std::unique_ptr<char[]>> blocks;
+		std::deque<std::string> buffers;
+#if !defined(_WIN32)
+		struct Unmap {
+			std::size_t size;
+			void operator()(char* address) const { ::munmap(address, size); }
+		};
+		std::vector<std::unique_ptr<char, Unmap>> mappings; //< Files mapped by map().
+#endif
 	};
 
 	/**
-	* @class Parser class
-	* @brief Base class for existing parsers. Contains methods which must be overwriten to implement functionality.
+	* @struct ConfigToken struct
+	* @brief A classified line produced by the tokenizer. Views point into the buffer being parsed.
 	*/
-	class Parser {
-	public:
-		Parser(std::string _path = "") :
-			path(_path), errorCode(ConfigError::NO_ERROR) {
+	struct ConfigToken {
+		ConfigType type;
+		std::string_view key; //< Key, section name or comment text.
+		std::string_view value; //< Value text, only set for CONFIG_VALUE tokens.
+		std::string_view line; //< Raw bytes of the line, including its line break.
+	};
 
-		}
-		virtual ~Parser() {} //< Implement a custom destructor.
+	/**
+	* @class Lexer class
+	* @brief Table driven tokenizer shared by the parsers.
+	* Walks the buffer once and yields a ConfigToken per recognised line without allocating. Characters that can change the state go
+	* through the transition table one at a time, runs that cannot (the rest of a key, value or comment) are skipped with findEither().
+	*/
+	class Lexer {
+	public:
+		Lexer(std::string_view _buffer) :
+			buffer(_buffer), position(0) {}
 
 		/**
-		* @brief Get the current path to the config file.
-		* @return REturns a constant std string for file path.
+		* @brief Extracts the next token, skipping lines that are neither comments, empty lines, sections nor values.
+		* @param token Receives the token type and views into the buffer.
+		* @return False once the buffer is exhausted.
 		*/
-		const std::string& getPath() const { return this->path; }
+		bool next(ConfigToken& token) {
+			while (position < buffer.size()) {
+				State state = LINE_START;
+				std::size_t lineStart = position, start = position, end = position, separator = position;
+				for (; position < buffer.size(); position++) {
+					CharClass type = charClass(buffer[position]);
+					if (type == CHAR_NEWLINE) {
+						break;
+					}
+					State nextState = transitions[state][type];
+					if (type != CHAR_SPACE) {
+						if (state == LINE_START) {
+							start = position;
+						}
+						end = position + 1;
+					}
+					if (nextState == VALUE && state != VALUE) {
+						separator = position;
+					}
+					state = nextState;
+					// Inside a key only '=' or the line end change the state, after '=' or '#' only the line end does.
+					// Vector scan to that byte, the bytes skipped only move end to the last one that is not a space.
+					if (state == KEY || state == COMMENT || state == VALUE || state == INVALID) {
+						std::size_t stop = findEither(buffer, position + 1, '\n', (state == KEY) ? '=' : '\n');
+						for (std::size_t last = stop; last > position + 1; last--) {
+							if (charClass(buffer[last - 1]) != CHAR_SPACE) {
+								end = last;
+								break;
+							}
+						}
+						position = stop - 1;
+					}
+				}
+				if (position < buffer.size()) {
+					position++;
+				}
+				if (emit(state, start, end, separator, token)) {
+					token.line = buffer.substr(lineStart, position - lineStart);
+					return true;
+				}
+			}
+			return false;
+		}
 
 		/**
-		* @brief Retrieves currently imitted error code.
-		* @return Returns a Config error enum state.
+		* @brief Byte offset of the next unread line.
 		*/
-		const ConfigError getError() const { return errorCode; }
+		std::size_t offset() const { return position; }
 
 		/**
-		* @brief Clears current eror state.
+		* @brief Moves the lexer to a line start.
 		*/
-		void flush() { errorCode = ConfigError::NO_ERROR; }
+		void seek(std::size_t offset) { position = std::min(offset, buffer.size()); }
 
 		/**
-		* @brief Loads a config file.
-		* @param String, file path.
+		* @brief Finds the next section header at or after a line start, using memchr to jump between lines.
+		* @return Offset of the header line, or the buffer size if there is none.
 		*/
-		virtual void load(std::string _path) {
-
-			flush();
-			erase();
-			path = _path;
-			readFile();
+		std::size_t findSection(std::size_t offset) const {
+			while (offset < buffer.size()) {
+				auto end = buffer.find('\n', offset);
+				if (end == std::string_view::npos) {
+					end = buffer.size();
+				}
+				std::string_view line = trimView(buffer.substr(offset, end - offset));
+				ConfigToken token;
+				if (!line.empty() && charClass(line.front()) == CHAR_SECTION_OPEN && Lexer(line).next(token) && token.type == ConfigType::CONFIG_SECTION) {
+					return offset;
+				}
+				offset = end + 1;
+			}
+			return buffer.size();
 		}
 
-		/**
-		* @brief Reloads an opened config file.
-		*/
-		virtual void reload() {
-			erase();
-			readFile();
-		}
+	private:
+		enum State : unsigned char {
+			LINE_START,
+			COMMENT,
+			SECTION,
+			SECTION_CLOSE,
+			KEY,
+			VALUE,
+			INVALID,
+			STATE_COUNT
+		};
+
+		// Next state indexed by [state][CharClass]. Newlines never reach the table, they end the line.
+		static constexpr State transitions[STATE_COUNT][CHAR_CLASS_COUNT] = {
+			//               OTHER    SPACE          NEWLINE     EQUALS   COMMENT  OPEN     CLOSE
+			/* LINE_START */ { KEY,     LINE_START,    LINE_START, INVALID, COMMENT, SECTION, KEY },
+			/* COMMENT */    { COMMENT, COMMENT,       COMMENT,    COMMENT, COMMENT, COMMENT, COMMENT },
+			/* SECTION */    { SECTION, SECTION,       SECTION,    VALUE,   SECTION, SECTION, SECTION_CLOSE },
+			/* SECTION_CLOSE */ { SECTION, SECTION_CLOSE, SECTION, VALUE, SECTION, SECTION, SECTION_CLOSE },
+			/* KEY */        { KEY,     KEY,           KEY,        VALUE,   KEY,     KEY,     KEY },
+			/* VALUE */      { VALUE,   VALUE,         VALUE,      VALUE,   VALUE,   VALUE,   VALUE },
+			/* INVALID */    { INVALID, INVALID,       INVALID,    INVALID, INVALID, INVALID, INVALID }
+		};
 
 		/**
-		* @brief Writes config data to the file path.
-		* @param String, path file, where file must be saved.
+		* @brief Builds the token for a finished line from its final state.
 		*/
-		virtual void save(std::string _path = "") {
-			if (!_path.empty()) {
-				path = _path;
+		bool emit(State state, std::size_t start, std::size_t end, std::size_t separator, ConfigToken& token) const {
+			switch (state) {
+			case LINE_START:
+				token = { ConfigType::CONFIG_EMPTY_LINE, {}, {}, {} };
+				return true;
+			case COMMENT:
+				token = { ConfigType::CONFIG_COMMENT, buffer.substr(start, end - start), {}, {} };
+				return true;
+			case SECTION_CLOSE:
+				token = { ConfigType::CONFIG_SECTION, trimView(buffer.substr(start + 1, end - start - 2)), {}, {} };
+				return !token.key.empty();
+			case VALUE:
+				token = { ConfigType::CONFIG_VALUE, trimView(buffer.substr(start, separator - start)), trimView(buffer.substr(separator + 1, end - separator - 1)), {} };
+				return !token.key.empty();
+			default:
+				return false;
 			}
-			write();
 		}
 
-	protected:
-		static inline bool fileExists(const std::string& filePath) { return std::filesystem::exists(filePath); } //< Checks if a file exists.
-		inline bool isComment(std::string str) { return starts_with(trim_copy(str), "#"); } //< Checks if string is a comment.
-		inline bool isEmptyLine(std::string str) { return trim_copy(str).empty(); } //< Check if string is an empty line.
-		inline bool isValue(const std::string& str) { return contains(str, "="); } //< Check if a string is a value.
+		std::string_view buffer;
+		std::size_t position;
+	};
+
+	/**
+	* @class ConfigHandler class
+	* @brief Receives events from ConfigReader. Override the events of interest, return false from any of them to stop reading.
+	* Views passed to the events are only valid for the duration of the call.
+	*/
+	class ConfigHandler {
+	public:
+		virtual ~ConfigHandler() {}
+
+		virtual bool onSection(std::string_view /*section*/) { return true; } //< Called for every section header.
+		virtual bool onKeyValue(std::string_view /*section*/, std::string_view /*key*/, std::string_view /*value*/) { return true; } //< Called for every value, section is empty for INI files.
+		virtual bool onComment(std::string_view /*comment*/) { return true; } //< Called for every comment line.
+		virtual bool onBlank() { return true; } //< Called for every empty line.
+	};
+
+	/**
+	* @class ConfigReader class
+	* @brief Event driven reader for INI and CFG data, for scanning files without building a document.
+	* Files are read in fixed size chunks and fed through the Lexer, so memory use is bounded by the chunk size and the longest line.
+	*/
+	class ConfigReader {
+	public:
+		/**
+		* @brief Constructor.
+		* @param _chunkSize Number of bytes read from the file at a time.
+		*/
+		ConfigReader(std::size_t _chunkSize = 65536) :
+			chunkSize(_chunkSize), stopped(false) {}
 
 		/**
-		* @brief Check if string is a section name.
+		* @brief Streams a file to the handler.
+		* @param filePath File to read.
+		* @param handler Receives the events.
+		* @return Error state of the read, NO_ERROR when the handler stopped early.
 		*/
-		inline bool isSection(std::string str) {
-			auto _str = trim_copy(str);
-			return (starts_with(_str, "[") && ends_with(_str, "]"));
+		ConfigError read(const std::string& filePath, ConfigHandler& handler) {
+			begin();
+			std::error_code error;
+			if (!std::filesystem::exists(filePath, error)) {
+				return ConfigError::FILE_NOT_FOUND;
+			}
+			std::ifstream stream(filePath, std::ios::in | std::ios::binary);
+			if (!stream.is_open()) {
+				return ConfigError::FILE_OPEN_ERROR;
+			}
+
+			std::string buffer(chunkSize, '\0');
+			std::size_t pending = 0;
+			bool end = false;
+			while (!end && !stopped) {
+				// A line longer than the buffer: grow it until the line fits.
+				if (pending == buffer.size()) {
+					buffer.resize(buffer.size() * 2);
+				}
+				stream.read(buffer.data() + pending, static_cast<std::streamsize>(buffer.size() - pending));
+				if (stream.bad()) {
+					return ConfigError::FILE_READ_ERROR;
+				}
+				std::size_t filled = pending + static_cast<std::size_t>(stream.gcount());
+				end = stream.eof();
+
+				std::string_view data(buffer.data(), filled);
+				std::size_t cut = filled;
+				if (!end) {
+					auto newline = data.rfind('\n');
+					cut = (newline == std::string_view::npos) ? 0 : newline + 1;
+				}
+				feed(data.substr(0, cut), handler);
+				pending = filled - cut;
+				std::memmove(buffer.data(), buffer.data() + cut, pending);
+			}
+			return ConfigError::NO_ERROR;
 		}
 
-		StringVector extractValue(const std::string& str) { return split(trim_copy(str), '='); } // Extracts the value from  the string.
 		/**
-		* @brief Extracts a section name from string.
+		* @brief Streams an in-memory buffer to the handler.
+		* @return False if the handler stopped early.
 		*/
-		std::string extractSection(std::string str) {
-			trim(str);
-			str.pop_back();
-			str.erase(0, 1);
-			return str;
+		bool parse(std::string_view buffer, ConfigHandler& handler) {
+			begin();
+			feed(buffer, handler);
+			return !stopped;
 		}
 
-		void appendLine(ConfigType type, std::string content) { lines.emplace_back(ConfigLine(type, std::move(content))); } //< Appends a line to the parser (used for parsing data to and from the file).
+		/**
+		* @brief Whether the handler stopped the last read early.
+		*/
+		bool aborted() const { return stopped; }
+
+	private:
+		void begin() {
+			section.clear();
+			stopped = false;
+		}
 
 		/**
-		* @brief Removes a specified line using it's content.
+		* @brief Tokenizes complete lines and dispatches them until the handler stops.
 		*/
-		void removeLine(const std::string& handle) {
-			for (int index = 0; index < lines.size(); index++) {
-				auto line = lines[index];
-				if (line.content == handle) {
-					lines.erase(lines.begin() + index);
+		void feed(std::string_view data, ConfigHandler& handler) {
+			Lexer lexer(data);
+			ConfigToken token;
+			while (!stopped && lexer.next(token)) {
+				switch (token.type) {
+				case ConfigType::CONFIG_SECTION:
+					section.assign(token.key);
+					stopped = !handler.onSection(section);
 					break;
+				case ConfigType::CONFIG_VALUE:
+					stopped = !handler.onKeyValue(section, token.key, token.value);
+					break;
+				case ConfigType::CONFIG_COMMENT:
+					stopped = !handler.onComment(token.key);
+					break;
+				case ConfigType::CONFIG_EMPTY_LINE:
+					stopped = !handler.onBlank();
+					break;
+				default:
+					break;
+				}
+			}
+		}
+
+		std::size_t chunkSize;
+		bool stopped;
+		std::string section; //< Current section name, kept across chunks.
+	};
+
+	/**
+	* @class ConfigValue
+	* @brief Base class for managing value data, handles different DataTypes and uses std::string to store them.
+	*
+	* Values set from code are kept in their native type, their text is only produced when the value is written or read as a string.
+	*/
+	class ConfigValue {
+	private:
+		std::string data;
+		mutable std::variant<std::monostate, int, std::int64_t, float, double, bool, char> typed; //< Native value set from code, or the last typed conversion of data so repeated reads skip parsing. Const reads fill the cache, so concurrent reads of one value need a lock.
+		bool native = false; //< The value lives in typed and data is empty.
+
+	public:
+		ConfigValue(): 
+			data("") {}
+		template<typename value_type>
+		ConfigValue(value_type _data = "") {
+			setData(_data);
+		}
+
+		template<typename value_type>
+		ConfigValue& operator=(value_type value) {
+			setData(value);
+			return *this;
+		}
+
+		operator std::string() const {
+			char buffer[formatSize];
+			return native ? std::string(formatNative(buffer)) : data;
+		}
+
+		template<typename value_type>
+		operator value_type() const {
+			if constexpr (std::is_same<value_type, std::string>::value) {
+				return operator std::string();
+			}
+			else {
+				value_type value{};
+				if (!tryConvert(value)) {
+					CONFIGPARSER_THROW(std::invalid_argument(typeErrorMsg(typeName<value_type>())));
 				}
+				return value;
 			}
 		}
 
 		/**
-		* @brief helper function to read file.
+		* @brief Converts the value without throwing or allocating (except for std::string).
+		* @return The converted value, or nothing if the text is not convertible to value_type.
 		*/
-		virtual void readFile() {
-			
-				if (!path.empty()) {
+		template<typename value_type>
+		std::optional<value_type> tryGet() const {
+			value_type value{};
+			if (!tryConvert(value)) {
+				return std::nullopt;
+			}
+			return value;
+		}
 
-					this->read();
+		/**
+		* @brief Converts the value without throwing, returning fallback if it is not convertible to value_type.
+		*/
+		template<typename value_type>
+		value_type getOr(value_type fallback) const {
+			value_type value{};
+			return tryConvert(value) ? value : fallback;
+		}
+
+		/**
+		* @brief Appends the text of the value to output, formatting native values in place.
+		*/
+		void appendTo(std::string& output) const {
+			char buffer[formatSize];
+			output += native ? formatNative(buffer) : std::string_view(data);
+		}
+
+		/**
+		* @brief Checks if the value is written as text, without allocating.
+		*/
+		bool hasText(std::string_view text) const {
+			char buffer[formatSize];
+			return (native ? formatNative(buffer) : std::string_view(data)) == text;
+		}
+
+		friend std::ostream& operator<<(std::ostream& os, const ConfigValue& cv) {
+			char buffer[formatSize];
+			os << (cv.native ? cv.formatNative(buffer) : std::string_view(cv.data));
+			return os;
+		}
+
+		template<typename value_type>
+		void setData(value_type value) {
+			data.clear();
+			typed = std::monostate();
+			native = false;
+			if constexpr (std::is_same<value_type, int>::value ||
+				std::is_same<value_type, std::int64_t>::value ||
+				std::is_same<value_type, float>::value ||
+				std::is_same<value_type, double>::value ||
+				std::is_same<value_type, bool>::value ||
+				std::is_same<value_type, char>::value) {
+				typed = value;
+				native = true;
+			}
+			else if constexpr (std::is_same<value_type, std::string>::value) {
+				data = value;
+			}
+			else if constexpr (std::is_same<value_type, const char*>::value) {
+				data = std::string(value);
+			}
+			else {
+				static_assert(sizeof(value_type) == 0, "unsupported value type");
+			}
+		}
+	private:
+		static constexpr std::size_t formatSize = 32; //< Fits any formatted native value.
+
+		/**
+		* @brief Formats the native value into buffer, which must hold formatSize characters.
+		* std::to_chars without a format gives the shortest text that parses back to the same value.
+		*/
+		std::string_view formatNative(char* buffer) const {
+			return std::visit([buffer](auto value) -> std::string_view {
+				using type = decltype(value);
+				if constexpr (std::is_same<type, std::monostate>::value) {
+					return std::string_view();
+				}
+				else if constexpr (std::is_same<type, bool>::value) {
+					return value ? "true" : "false";
+				}
+				else if constexpr (std::is_same<type, char>::value) {
+					buffer[0] = value;
+					return std::string_view(buffer, 1);
 				}
+				else {
+					return std::string_view(buffer, std::to_chars(buffer, buffer + formatSize, value).ptr - buffer);
+				}
+			}, typed);
 		}
 
-		virtual void read() = 0; //< Override for implementation. (reads data from file)
-		virtual void write() = 0;//< Override for implementation. (writes data to file)
+		static inline std::string typeErrorMsg(const std::string& type) { return "String value is non convertible to type " + type; }
+
+		template<typename value_t>
+		static const char* typeName() {
+			if constexpr (std::is_same<value_t, int>::value) {
+				return "int";
+			}
+			else if constexpr (std::is_same<value_t, std::int64_t>::value) {
+				return "int64";
+			}
+			else if constexpr (std::is_same<value_t, float>::value) {
+				return "float";
+			}
+			else if constexpr (std::is_same<value_t, double>::value) {
+				return "double";
+			}
+			else if constexpr (std::is_same<value_t, char>::value) {
+				return "char";
+			}
+			else {
+				return "bool";
+			}
+		}
 
 		/**
-		* @brief Takes cair of clearing lines. (can be overwriten for implementation)
+		* @brief Converts to value_t through the typed cache. Never throws.
 		*/
-		virtual void erase() {
-			lines.clear();
-			lines.shrink_to_fit();
+		template<typename value_t>
+		bool tryConvert(value_t& value) const {
+			if constexpr (std::is_same<value_t, std::string>::value) {
+				value = operator std::string();
+				return true;
+			}
+			else {
+				if (auto cached = std::get_if<value_t>(&typed)) {
+					value = *cached;
+					return true;
+				}
+				if (native) {
+					// Read as another type: convert its text, so conversions behave as if the value had been loaded from a file.
+					char buffer[formatSize];
+					return parseText(formatNative(buffer), value);
+				}
+				if (!parseText(data, value)) {
+					return false;
+				}
+				typed = value;
+				return true;
+			}
 		}
 
-		ConfigError errorCode;
-		std::string path;
-		std::fstream file;
-		LineVector lines;
+		/**
+		* @brief Parses text as value_t. Numbers go through std::from_chars, which ignores the locale and needs no null terminated copy.
+		* The whole text must be a number, an optional leading '+' is accepted as std::stoi did.
+		*/
+		template<typename value_t>
+		static bool parseText(std::string_view str, value_t& value) {
+			if constexpr (std::is_same<value_t, int>::value ||
+				std::is_same<value_t, std::int64_t>::value ||
+				std::is_same<value_t, float>::value ||
+				std::is_same<value_t, double>::value) {
+				if (str.size() > 1 && str[0] == '+' && str[1] != '-') {
+					str.remove_prefix(1);
+				}
+				auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+				return !str.empty() && error == std::errc() && end == str.data() + str.size();
+			}
+			else if constexpr (std::is_same<value_t, char>::value) {
+				if (str.length() != 1) {
+					return false;
+				}
+				value = str[0];
+				return true;
+			}
+			else if constexpr (std::is_same<value_t, bool>::value) {
+				if (str != "true" && str != "false") {
+					return false;
+				}
+				value = (str == "true");
+				return true;
+			}
+			else {
+				static_assert(sizeof(value_t) == 0, "unsupported conversion type");
+			}
+		}
+
+
 	};
 
 	/**
-	* @class ConfigSection class
- * @brief Represents a configuration section with key-value pairs.
- */
-	class ConfigSection {
+	* @class ValueMap class
+	* @brief Flat hash map from keys to values which iterates in insertion order.
+	*
+	* Entries are stored contiguously in insertion order, an open addressing index of entry positions points into them.
+	* Each entry keeps its hash, so probing compares strings only on a hash match. Removal leaves a tombstone and costs O(1),
+	* the entries are compacted once tombstones outnumber live ones. Like std::vector, inserting or removing a key may move the
+	* other values, so references to values are only valid until the next insertion or removal.
+	*/
+	class ValueMap {
+		struct Entry;
+
 	public:
-		ConfigSection() {}
-		~ConfigSection() { clear(); }
+		/**
+		* @class KeyIterator class
+		* @brief Forward iterator over the keys in insertion order, skipping removed entries.
+		*/
+		class KeyIterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::string;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const std::string*;
+			using reference = const std::string&;
+
+			KeyIterator() : current(nullptr), last(nullptr) {}
+			KeyIterator(const Entry* _current, const Entry* _last) :
+				current(_current), last(_last) { skip(); }
+
+			reference operator*() const { return current->key; }
+			pointer operator->() const { return &current->key; }
+			KeyIterator& operator++() {
+				current++;
+				skip();
+				return *this;
+			}
+			KeyIterator operator++(int) {
+				KeyIterator previous = *this;
+				++*this;
+				return previous;
+			}
+			bool operator==(const KeyIterator& other) const { return current == other.current; }
+			bool operator!=(const KeyIterator& other) const { return current != other.current; }
+
+		private:
+			void skip() {
+				while (current != last && current->removed) {
+					current++;
+				}
+			}
+
+			const Entry* current;
+			const Entry* last;
+		};
+
+		ValueMap() :
+			live(0), used(0) {}
+
+		ConfigValue* find(std::string_view key) { return const_cast<ConfigValue*>(static_cast<const ValueMap*>(this)->find(key)); } //< Gets the value of a key, or nullptr.
 
 		/**
-		 * @brief Inserts a key-value pair if the key doesn't exist.
-		 * @param key The key to insert.
-		 * @param value The value to associate with the key.
+		* @brief Gets the value of a key for writing, or nullptr. The key is recorded in changedKeys().
+		*/
+		ConfigValue* modify(std::string_view key) {
+			std::size_t slot = locate(key, hashKey(key));
+			return (slot != npos) ? &record(entries[slots[slot] - 1]).value : nullptr;
+		}
+
+		/**
+		* @brief Gets the value of a key, or nullptr.
+		*/
+		const ConfigValue* find(std::string_view key) const {
+			std::size_t slot = locate(key, hashKey(key));
+			return (slot != npos) ? &entries[slots[slot] - 1].value : nullptr;
+		}
+
+		bool contains(std::string_view key) const { return find(key) != nullptr; } //< Checks if a key exists.
+		std::size_t size() const { return live; } //< Number of keys.
+		bool empty() const { return live == 0; } //< Checks if there are no keys.
+
+		/**
+		* @brief Inserts a key at the end of the order unless it already exists.
+		* @return The value of the key and whether it was inserted.
+		*/
+		std::pair<ConfigValue*, bool> tryEmplace(std::string_view key, ConfigValue value = ConfigValue()) {
+			auto [entry, inserted] = emplace(key, std::move(value));
+			return { &entry->value, inserted };
+		}
+
+		/**
+		* @brief Gets the value of a key for writing, inserting an empty value at the end of the order if it is missing.
+		* An existing key is recorded in changedKeys().
+		*/
+		ConfigValue& modifyOrInsert(std::string_view key) {
+			auto [entry, inserted] = emplace(key, ConfigValue());
+			return inserted ? entry->value : record(*entry).value;
+		}
+
+		/**
+		* @brief Keys that existed before they were handed out for writing, in the order of their first change. Removed keys leave the list.
+		*/
+		const StringVector& changedKeys() const { return changed; }
+
+		/**
+		* @brief Removes a key, leaving a tombstone in its place.
+		* @return True if the key existed.
+		*/
+		bool erase(std::string_view key) {
+			std::size_t slot = locate(key, hashKey(key));
+			if (slot == npos) {
+				return false;
+			}
+			Entry& entry = entries[slots[slot] - 1];
+			if (entry.changed) {
+				changed.erase(std::find(changed.begin(), changed.end(), entry.key));
+			}
+			entry.removed = true;
+			entry.key = std::string();
+			entry.value = ConfigValue();
+			slots[slot] = removedSlot;
+			live--;
+			if (entries.size() > 8 && live * 2 < entries.size()) {
+				rehash(live);
+			}
+			return true;
+		}
+
+		/**
+		* @brief Removes every key.
+		*/
+		void clear() {
+			entries.clear();
+			slots.clear();
+			changed.clear();
+			live = 0;
+			used = 0;
+		}
+
+		KeyIterator begin() const { return KeyIterator(entries.data(), entries.data() + entries.size()); }
+		KeyIterator end() const { return KeyIterator(entries.data() + entries.size(), entries.data() + entries.size()); }
+
+	private:
+		struct Entry {
+			std::string key;
+			ConfigValue value;
+			std::size_t hash;
+			bool removed;
+			bool changed; //< Listed in changed.
+		};
+
+		static constexpr std::uint32_t emptySlot = 0;
+		static constexpr std::uint32_t removedSlot = UINT32_MAX;
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+		static std::size_t hashKey(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+		/**
+		* @brief Lists an entry in changed the first time it is handed out for writing.
+		*/
+		Entry& record(Entry& entry) {
+			if (!entry.changed) {
+				entry.changed = true;
+				changed.push_back(entry.key);
+			}
+			return entry;
+		}
+
+		/**
+		* @brief Finds a key or inserts it at the end of the order.
+		* @return The entry of the key and whether it was inserted.
+		*/
+		std::pair<Entry*, bool> emplace(std::string_view key, ConfigValue value) {
+			std::size_t hash = hashKey(key);
+			std::size_t slot = locate(key, hash);
+			if (slot != npos) {
+				return { &entries[slots[slot] - 1], false };
+			}
+			if ((used + 1) * 4 > slots.size() * 3) {
+				rehash(live + 1);
+			}
+			std::size_t mask = slots.size() - 1;
+			for (slot = hash & mask; slots[slot] != emptySlot && slots[slot] != removedSlot; slot = (slot + 1) & mask) {}
+			used += (slots[slot] == emptySlot);
+			entries.push_back({ std::string(key), std::move(value), hash, false, false });
+			slots[slot] = static_cast<std::uint32_t>(entries.size());
+			live++;
+			return { &entries.back(), true };
+		}
+
+		/**
+		* @brief Finds the slot holding a key, or npos.
+		*/
+		std::size_t locate(std::string_view key, std::size_t hash) const {
+			if (slots.empty()) {
+				return npos;
+			}
+			std::size_t mask = slots.size() - 1;
+			for (std::size_t slot = hash & mask; slots[slot] != emptySlot; slot = (slot + 1) & mask) {
+				if (slots[slot] != removedSlot) {
+					const Entry& entry = entries[slots[slot] - 1];
+					if (entry.hash == hash && entry.key == key) {
+						return slot;
+					}
+				}
+			}
+			return npos;
+		}
+
+		/**
+		* @brief Drops tombstones from the entries, keeping their order, and rebuilds the index for at least count keys.
+		*/
+		void rehash(std::size_t count) {
+			if (live != entries.size()) {
+				entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry& entry) { return entry.removed; }), entries.end());
+			}
+			std::size_t capacity = 8;
+			while (capacity < count * 2) {
+				capacity *= 2;
+			}
+			slots.assign(capacity, emptySlot);
+			for (std::size_t index = 0; index < entries.size(); index++) {
+				std::size_t slot = entries[index].hash & (capacity - 1);
+				while (slots[slot] != emptySlot) {
+					slot = (slot + 1) & (capacity - 1);
+				}
+				slots[slot] = static_cast<std::uint32_t>(index + 1);
+			}
+			used = entries.size();
+		}
+
+		std::vector<Entry> entries; //< Insertion order, removed entries stay as tombstones until the next rehash.
+		std::vector<std::uint32_t> slots; //< Open addressing index, holds entry position + 1, emptySlot or removedSlot.
+		StringVector changed; //< See changedKeys().
+		std::size_t live; //< Entries not removed.
+		std::size_t used; //< Slots not empty, tombstones included, bounds the probe length.
+	};
+
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	/**
+	* @class AwaitWorkers class
+	* @brief Shared worker threads running awaitable operations when no executor is given. Created on first use, the destructor
+	* runs the queued tasks and joins the threads at program exit.
+	*/
+	class AwaitWorkers {
+	public:
+		/**
+		 * @brief Process wide instance.
 		 */
-template<typename value_type>
-		void insert(std::string key, value_type value) {
-			if (!dict.contains(key)) {
-				std::string& _key = key;
-				keys.push_back(_key);
-				dict.emplace(_key,ConfigValue(value));
+		static AwaitWorkers& shared() {
+			static AwaitWorkers workers(std::max(1u, std::thread::hardware_concurrency()));
+			return workers;
+		}
+
+		~AwaitWorkers() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
 			}
+			wake.notify_all();
+			for (auto& thread : threads) {
+				thread.join();
+			}
+		}
+
+		AwaitWorkers(const AwaitWorkers&) = delete;
+		AwaitWorkers& operator=(const AwaitWorkers&) = delete;
+
+		/**
+		 * @brief Queues a task for the next free worker.
+		 */
+		void post(std::function<void()> task) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				tasks.push_back(std::move(task));
+			}
+			wake.notify_one();
+		}
+
+	private:
+		AwaitWorkers(unsigned threadCount) : stopping(false) {
+			for (unsigned index = 0; index < threadCount; index++) {
+				threads.emplace_back(&AwaitWorkers::run, this);
+			}
+		}
+
+		/**
+		 * @brief Worker thread, runs queued tasks until stopping and the queue is empty.
+		 */
+		void run() {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true) {
+				wake.wait(lock, [this] { return !tasks.empty() || stopping; });
+				if (tasks.empty()) {
+					break;
+				}
+				std::function<void()> task = std::move(tasks.front());
+				tasks.pop_front();
+				lock.unlock();
+				task();
+				lock.lock();
+			}
+		}
+
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable wake; //< Signals the workers: a task or stopping.
+		std::deque<std::function<void()>> tasks;
+		bool stopping;
+	};
+
+	/**
+	* @class ConfigAwaitable class
+	* @brief Awaitable returned by the Parser await functions. Runs the operation on the executor and resumes the coroutine there once it finished.
+	*/
+	class ConfigAwaitable {
+	public:
+		ConfigAwaitable(std::function<ConfigError()> _operation, Executor _executor) :
+			operation(std::move(_operation)), executor(std::move(_executor)), result(ConfigError::NO_ERROR) {}
+
+		bool await_ready() const noexcept { return false; }
+
+		/**
+		 * @brief Hands the operation to the executor. The executor is copied first, as a task run inline may resume and destroy
+		 * the awaitable before the call returns, so no member is touched after it.
+		 */
+		void await_suspend(std::coroutine_handle<> handle) {
+			auto task = [this, handle] {
+				result = operation();
+				handle.resume();
+			};
+			if (!executor) {
+				AwaitWorkers::shared().post(std::move(task));
+				return;
+			}
+			Executor run = executor;
+			run(std::move(task));
+		}
+
+		ConfigError await_resume() const noexcept { return result; }
+
+	private:
+		std::function<ConfigError()> operation;
+		Executor executor;
+		ConfigError result;
+	};
+#endif
+
+	/**
+	* @class Parser class
+	* @brief Base class for existing parsers. Contains methods which must be overwriten to implement functionality.
+	*
+	* Asynchronous operations: while loadAsync() or reloadAsync() is in flight, the parser must not be accessed except through isBusy().
+	* The parser must outlive the operation. saveAsync() serializes the document before it returns, the parser may be used and modified right away.
+	*
+	* Lines: removing a line leaves a CONFIG_REMOVED tombstone, so the positions of the other lines do not move. Tombstones are compacted
+	* once they make up half of the lines. Lines of the indexed type (keys for INI, sections for CFG) are found through an index from
+	* their content to their position, which is extended lazily as lines are appended.
+	*/
+	class Parser {
+	public:
+		Parser(std::string _path = "", ConfigType _indexedType = ConfigType::CONFIG_VALUE) :
+			path(_path), errorCode(ConfigError::NO_ERROR), busy(false), indexedType(_indexedType), indexedLines(0), removedLines(0) {
+
+		}
+		virtual ~Parser() {} //< Implement a custom destructor.
+
+		/**
+		* @brief Get the current path to the config file.
+		* @return REturns a constant std string for file path.
+		*/
+		const std::string& getPath() const { return this->path; }
+
+		/**
+		* @brief Retrieves currently imitted error code.
+		* @return Returns a Config error enum state.
+		*/
+		const ConfigError getError() const { return errorCode; }
+
+		/**
+		* @brief Clears current eror state.
+		*/
+		void flush() { errorCode = ConfigError::NO_ERROR; }
+
+		/**
+		* @brief Retrieves the sections and keys that changed during the last reload.
+		*/
+		const ChangeVector& getChanges() const { return changes; }
+
+		/**
+		* @brief Loads a config file.
+		* @param String, file path.
+		*/
+		virtual void load(std::string _path) {
+
+			flush();
+			erase();
+			changes.clear();
+			path = _path;
+			readFile();
+		}
+
+		/**
+		* @brief Reloads an opened config file.
+		* Parsers override this to only reparse what changed on disk and to report the differences through getChanges().
+		*/
+		virtual void reload() {
+			erase();
+			changes.clear();
+			readFile();
+		}
+
+		/**
+		* @brief Writes config data to the file path.
+		* @param String, path file, where file must be saved.
+		*/
+		virtual void save(std::string _path = "") {
+			if (!_path.empty()) {
+				path = _path;
+			}
+			write();
+		}
+
+		/**
+		* @brief Loads subsequent files through a read only memory mapping instead of reading them into a buffer, see TextArena::map().
+		* Line text and lazily parsed section bodies then view the mapping, keys and values are still copied into the document,
+		* since values can be copied out of the parser and outlive it. Reloads keep reading the file.
+		*/
+		void setMapped(bool _mapped) { mapped = _mapped; }
+
+		/**
+		* @brief Loads config data already in memory. The file path is left unchanged.
+		* @param buffer Config text, copied once into the parser's arena so the caller's buffer may be released afterwards.
+		*/
+		void loadFromBuffer(std::string_view buffer) {
+			flush();
+			erase();
+			changes.clear();
+			source = arena.store(buffer);
+			parse(source);
+		}
+
+		/**
+		* @brief Loads config data from a stream, such as a pipe or an archive entry. The file path is left unchanged.
+		* @param stream Stream read until its end.
+		*/
+		void loadFromStream(std::istream& stream) {
+			flush();
+			erase();
+			changes.clear();
+			constexpr std::size_t chunkSize = 64 * 1024;
+			std::string buffer;
+			while (stream) {
+				std::size_t size = buffer.size();
+				buffer.resize(size + chunkSize);
+				stream.read(buffer.data() + size, static_cast<std::streamsize>(chunkSize));
+				buffer.resize(size + static_cast<std::size_t>(stream.gcount()));
+			}
+			if (stream.bad()) {
+				errorCode = ConfigError::FILE_READ_ERROR;
+				return;
+			}
+			source = arena.adopt(std::move(buffer));
+			parse(source);
+		}
+
+		/**
+		* @brief Serializes config data to a stream.
+		*/
+		void saveToStream(std::ostream& stream) {
+			std::string text = saveToString();
+			stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+		}
+
+		/**
+		* @brief Hash of the file currently at the parser's path, as recorded in snapshots. 0 if it cannot be read.
+		*/
+		std::uint64_t sourceHash() {
+			std::string buffer;
+			ConfigError previous = errorCode;
+			bool success = readBuffer(buffer);
+			errorCode = previous;
+			return success ? hashBytes(buffer) : 0;
+		}
+
+		/**
+		* @brief Checks if an asynchronous load or reload is in flight.
+		*/
+		bool isBusy() const { return busy; }
+
+		/**
+		* @brief Loads a config file without blocking the calling thread.
+		* @param _path File path.
+		* @param executor Runs the load, a dedicated thread is used when empty.
+		* @return Future holding the error state of the load.
+		*/
+		std::future<ConfigError> loadAsync(std::string _path, Executor executor = {}) {
+			return runAsync(loadOperation(std::move(_path)), std::move(executor));
+		}
+
+		/**
+		* @brief Reloads the config file without blocking the calling thread.
+		*/
+		std::future<ConfigError> reloadAsync(Executor executor = {}) {
+			return runAsync(reloadOperation(), std::move(executor));
+		}
+
+		/**
+		* @brief Serializes the document on the calling thread, then writes it without blocking.
+		* @param _path File path, the current path is used when empty.
+		* @param executor Runs the write, a dedicated thread is used when empty.
+		*/
+		std::future<ConfigError> saveAsync(std::string _path = "", Executor executor = {}) {
+			return runAsync(saveOperation(std::move(_path)), std::move(executor));
+		}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+		ConfigAwaitable awaitLoad(std::string _path, Executor executor = {}) { return ConfigAwaitable(loadOperation(std::move(_path)), std::move(executor)); } //< Awaitable form of loadAsync().
+		ConfigAwaitable awaitReload(Executor executor = {}) { return ConfigAwaitable(reloadOperation(), std::move(executor)); } //< Awaitable form of reloadAsync().
+		ConfigAwaitable awaitSave(std::string _path = "", Executor executor = {}) { return ConfigAwaitable(saveOperation(std::move(_path)), std::move(executor)); } //< Awaitable form of saveAsync().
+#endif
+
+		/**
+		* @brief Serializes config data to a string.
+		*/
+		std::string saveToString() {
+			std::string text;
+			serialize(text);
+			return text;
+		}
+
+	protected:
+		static inline bool fileExists(const std::string& filePath) { std::error_code error; return std::filesystem::exists(filePath, error); } //< Checks if a file exists.
+
+		/**
+		* @brief Runs an operation on the executor, or on a new thread through std::async when none is given.
+		*/
+		static std::future<ConfigError> runAsync(std::function<ConfigError()> operation, Executor executor) {
+			if (!executor) {
+				return std::async(std::launch::async, std::move(operation));
+			}
+			auto task = std::make_shared<std::packaged_task<ConfigError()>>(std::move(operation));
+			auto future = task->get_future();
+			executor([task] { (*task)(); });
+			return future;
+		}
+
+		std::function<ConfigError()> loadOperation(std::string _path) {
+			busy = true;
+			return [this, _path] {
+				load(_path);
+				busy = false;
+				return errorCode;
+			};
+		}
+
+		std::function<ConfigError()> reloadOperation() {
+			busy = true;
+			return [this] {
+				reload();
+				busy = false;
+				return errorCode;
+			};
+		}
+
+		/**
+		* @brief Serializes the document now and returns an operation writing it, which does not touch the parser.
+		*/
+		std::function<ConfigError()> saveOperation(std::string _path) {
+			if (!_path.empty()) {
+				path = _path;
+			}
+			return [target = path, text = saveToString()] {
+				return target.empty() ? ConfigError::NO_ERROR : writeFileBuffer(target, text);
+			};
+		}
+
+		/**
+		* @brief Reads the whole config file into a single contiguous buffer with one read call.
+		* @param buffer Destination buffer, resized to the file size.
+		* @return True on success, otherwise the error code is set.
+		*/
+		bool readBuffer(std::string& buffer) {
+			ConfigError result = readFileBuffer(path, buffer);
+			if (result != ConfigError::NO_ERROR) {
+				errorCode = result;
+				return false;
+			}
+			return true;
+		}
+
+
+		void appendLine(ConfigType type, std::string_view content) { lines.push_back({ type, arena.store(content), {} }); } //< Appends a line to the parser, copying its content into the arena.
+		void appendParsedLine(ConfigType type, std::string_view content, std::string_view text) { lines.push_back({ type, content, text }); } //< Appends a line whose content and text already live in the arena (parsed tokens).
+
+		/**
+		* @brief Appends the loaded bytes of a line, adding the line break the last line of a file may lack.
+		*/
+		static void appendLoaded(std::string& output, std::string_view text) {
+			output += text;
+			if (text.back() != '\n') {
+				output += '\n';
+			}
+		}
+
+		/**
+		* @brief Checks if a value line can be written back as it was loaded, with the value it had in the file.
+		*/
+		static bool isUnchanged(const ConfigLine& line, const ConfigValue& value) {
+			ConfigToken token;
+			return !line.text.empty() && Lexer(line.text).next(token) && value.hasText(token.value);
+		}
+
+		/**
+		* @brief Finds the first line of the indexed type with the given content.
+		* @return Its position in lines, or lines.size() if there is none.
+		*/
+		std::size_t findLine(std::string_view content) {
+			if (indexedLines > lines.size()) {
+				resetLineIndex();
+			}
+			for (; indexedLines < lines.size(); indexedLines++) {
+				if (lines[indexedLines].type == indexedType) {
+					lineIndex.try_emplace(lines[indexedLines].content, indexedLines);
+				}
+			}
+			auto iter = lineIndex.find(content);
+			return (iter != lineIndex.end()) ? iter->second : lines.size();
+		}
+
+		/**
+		* @brief Removes the first line of the indexed type with the given content.
+		*/
+		void removeLine(std::string_view content) {
+			std::size_t index = findLine(content);
+			if (index < lines.size()) {
+				removeLines(index, index + 1);
+			}
+		}
+
+		/**
+		* @brief Replaces the lines in [first, last) with tombstones, compacting them when they make up half of the lines.
+		*/
+		void removeLines(std::size_t first, std::size_t last) {
+			for (std::size_t index = first; index < last; index++) {
+				if (lines[index].type == ConfigType::CONFIG_REMOVED) {
+					continue;
+				}
+				if (lines[index].type == indexedType) {
+					auto iter = lineIndex.find(lines[index].content);
+					if (iter != lineIndex.end() && iter->second == index) {
+						lineIndex.erase(iter);
+					}
+				}
+				lines[index] = { ConfigType::CONFIG_REMOVED, {}, {} };
+				removedLines++;
+			}
+			if (removedLines * 2 > lines.size()) {
+				lines.erase(std::remove_if(lines.begin(), lines.end(), [](const ConfigLine& line) { return line.type == ConfigType::CONFIG_REMOVED; }), lines.end());
+				resetLineIndex();
+			}
+		}
+
+		/**
+		* @brief Drops the line index, call after lines were inserted in the middle or replaced. Appending lines needs no reset.
+		*/
+		void resetLineIndex() {
+			lineIndex.clear();
+			indexedLines = 0;
+			removedLines = static_cast<std::size_t>(std::count_if(lines.begin(), lines.end(), [](const ConfigLine& line) { return line.type == ConfigType::CONFIG_REMOVED; }));
+		}
+
+		/**
+		* @brief helper function to read file.
+		*/
+		virtual void readFile() {
+			
+				if (!path.empty()) {
+
+					this->read();
+				}
+		}
+
+		/**
+		* @brief Loads the file into memory and hands it to the parser.
+		* The buffer is kept in the arena, so parsed lines can reference it without copying.
+		*/
+		virtual void read() {
+			if (mapped) {
+				ConfigError result = arena.map(path, source);
+				if (result != ConfigError::NO_ERROR) {
+					errorCode = result;
+					return;
+				}
+				parse(source);
+				return;
+			}
+			std::string buffer;
+			if (readBuffer(buffer)) {
+				source = arena.adopt(std::move(buffer));
+				parse(source);
+			}
+		}
+
+		virtual void parse(std::string_view buffer) = 0; //< Override for implementation. (parses data read from file)
+		virtual void serialize(std::string& output) = 0; //< Override for implementation. (appends the serialized document to output)
+
+		/**
+		* @brief Writes the serialized document to the file path. The document is formatted into one buffer and written with a single call.
+		* Change tracking is kept across saves: a reference handed out before the save may still write the value, so every key changed since the load
+		* is compared with the loaded text again on the next save.
+		*/
+		virtual void write() {
+			if (!path.empty()) {
+				ConfigError error = writeFileBuffer(path, saveToString());
+				if (error != ConfigError::NO_ERROR) {
+					errorCode = error;
+				}
+			}
+		}
+
+		/**
+		* @brief Capacity to reserve before serializing, the loaded text plus room for every line's separators and values.
+		*/
+		std::size_t serializedSizeHint() const { return source.size() + lines.size() * 16; }
+
+		/**
+		* @brief Takes cair of clearing lines. (can be overwriten for implementation)
+		*/
+		virtual void erase() {
+			lines.clear();
+			lines.shrink_to_fit();
+			resetLineIndex();
+			arena.clear();
+			source = std::string_view();
+		}
+
+		/**
+		* @brief Maps a view into the from buffer to the same bytes in the to buffer. Views outside from are copied into the arena.
+		*/
+		std::string_view rebase(std::string_view view, std::string_view from, std::string_view to) {
+			std::less_equal<const char*> before;
+			if (view.empty()) {
+				return view;
+			}
+			if (before(from.data(), view.data()) && before(view.data() + view.size(), from.data() + from.size())) {
+				return to.substr(static_cast<std::size_t>(view.data() - from.data()), view.size());
+			}
+			return arena.store(view);
+		}
+
+		ConfigError errorCode;
+		std::string path;
+		LineVector lines;
+		TextArena arena; //< Owns the loaded file and all line text, freed at once on erase.
+		std::string_view source; //< The loaded file as held by the arena.
+		bool mapped = false; //< Load files through TextArena::map(), see setMapped().
+		ChangeVector changes;
+		std::atomic<bool> busy;
+		ConfigType indexedType; //< Type of the lines found through lineIndex.
+		std::unordered_map<std::string_view, std::size_t> lineIndex; //< Content of indexed lines to their position, covers lines[0, indexedLines).
+		std::size_t indexedLines;
+		std::size_t removedLines; //< Tombstones in lines.
+	};
+
+	/**
+	* @class ConfigSection class
+ * @brief Represents a configuration section with key-value pairs.
+ */
+	class ConfigSection {
+	public:
+		ConfigSection() {}
+		ConfigSection(const ConfigSection&) = default;
+		ConfigSection(ConfigSection&&) = default;
+		ConfigSection& operator=(const ConfigSection&) = default;
+		ConfigSection& operator=(ConfigSection&&) = default;
+		~ConfigSection() { clear(); }
+
+		/**
+		 * @brief Inserts a key-value pair if the key doesn't exist.
+		 * @param key The key to insert.
+		 * @param value The value to associate with the key.
+		 */
+template<typename value_type>
+		void insert(std::string_view key, value_type value) {
+			if (dict.tryEmplace(key, ConfigValue(value)).second) {
+				modified = true;
+			}
+		}
+
+		/**
+		 * @brief Removes and returns the value associated with the key.
+		 * @param key The key to remove.
+		 * @return The value associated with the key.
+		 */
+		virtual ConfigValue pop(std::string_view key) {
+			ConfigValue* found = dict.find(key);
+			if (!found) {
+				return ConfigValue();
+			}
+			ConfigValue value = std::move(*found);
+			dict.erase(key);
+			modified = true;
+			return value;
+		}
+
+		/**
+		 * @brief Removes a key-value pair.
+		 * @param key The key to remove.
+		 */
+		virtual void remove(std::string_view key) {
+			if (dict.erase(key)) {
+				modified = true;
+			}
+		}
+
+		/**
+		 * @brief Updates the value of an existing key.
+		 * @param key The key to update.
+		 * @param value The new value.
+		 */
+		template<typename value_type>
+		void update(std::string_view key, value_type value) {
+			if (ConfigValue* found = dict.modify(key)) {
+				*found = value;
+				modified = true;
+			}
+		}
+
+		/**
+		 * @brief Checks if a key exists.
+		 * @param key The key to check.
+		 * @return True if the key exists, false otherwise.
+		 */
+		bool exists(std::string_view key) const { return dict.contains(key); }
+
+		/**
+		 * @brief Clears all key-value pairs.
+		 */
+		virtual void clear() {
+			dict.clear();
+			modified = true;
+		}
+
+		/**
+		 * @brief Checks if the section may have changed since it was loaded.
+		 * Any access handing out a mutable value counts as a change, as does a key repeated in the file.
+		 */
+		bool isModified() const { return modified; }
+
+		/**
+		 * @brief Gets the value associated with a key.
+		 * @param key The key to look up.
+		 * @return The value associated with the key.
+		 * @throw std::out_of_range if the key doesn't exist.
+		 */
+		ConfigValue& get(std::string_view key) {
+			if (ConfigValue* found = dict.modify(key)) {
+				modified = true;
+				return *found;
+			}
+			else {
+				CONFIGPARSER_THROW(std::out_of_range("Non existent key: " + std::string(key)));
+			}
+		}
+
+		/**
+		 * @brief Gets the value associated with a key.
+		 * @throw std::out_of_range if the key doesn't exist.
+		 */
+		const ConfigValue& get(std::string_view key) const {
+			if (const ConfigValue* found = dict.find(key)) {
+				return *found;
+			}
+			else {
+				CONFIGPARSER_THROW(std::out_of_range("Non existent key: " + std::string(key)));
+			}
+		}
+
+		/**
+		 * @brief Gets a value converted to value_type, without throwing.
+		 * @param key The key to look up.
+		 * @return The value, or nothing if the key doesn't exist or its value is not convertible.
+		 */
+		template<typename value_type>
+		std::optional<value_type> tryGet(std::string_view key) const {
+			const ConfigValue* found = dict.find(key);
+			return found ? found->tryGet<value_type>() : std::nullopt;
+		}
+
+		/**
+		 * @brief Gets a value converted to value_type, or fallback if the key doesn't exist or is not convertible. Never throws.
+		 */
+		template<typename value_type>
+		value_type getOr(std::string_view key, value_type fallback) const {
+			const ConfigValue* found = dict.find(key);
+			return found ? found->getOr<value_type>(std::move(fallback)) : fallback;
+		}
+
+		virtual ConfigValue& operator[](std::string_view key) {
+			modified = true;
+			return dict.modifyOrInsert(key);
+		}
+
+		std::size_t size() const { return dict.size(); } //< Number of keys.
+
+		ValueMap::KeyIterator begin() const { return dict.begin(); } //< Iterates the keys in insertion order.
+		ValueMap::KeyIterator end() const { return dict.end(); }
+
+	protected:
+		friend class CfgParser;
+		friend class IniParser;
+
+		ValueMap dict; //< Keys and values in insertion order.
+		bool modified = false;
+	};
+
+	/**
+	* @brief Appends the keys that differ between two versions of a section to changes.
+	*/
+	static inline void diffSection(const std::string& sectionName, const ConfigSection& before, const ConfigSection& after, ChangeVector& changes) {
+		for (auto& key : after) {
+			if (!before.exists(key)) {
+				changes.push_back({ ChangeType::ADDED, sectionName, key });
+			}
+			else if (static_cast<std::string>(before.get(key)) != static_cast<std::string>(after.get(key))) {
+				changes.push_back({ ChangeType::MODIFIED, sectionName, key });
+			}
+		}
+		for (auto& key : before) {
+			if (!after.exists(key)) {
+				changes.push_back({ ChangeType::REMOVED, sectionName, key });
+			}
+		}
+	}
+
+	/**
+	* @class ConfigSnapshot class
+	* @brief Read only binary snapshot of a parsed config, answering lookups straight from the loaded bytes.
+	*
+	* Layout: a 32 byte header (magic, version, source file hash, counts), the section table, the entry table,
+	* an open addressing hash index over (section, key) and the string table. Loading validates the tables once,
+	* lookups then neither parse nor allocate. Values are stored as text, as ConfigValue holds them.
+	*/
+	class ConfigSnapshot {
+	public:
+		static constexpr std::uint32_t version = 1;
+
+		ConfigSnapshot() :
+			sectionCount(0), entryCount(0), slotCount(0), sourceHash(0) {}
+
+		/**
+		 * @brief Loads a snapshot.
+		 * @param snapshotPath Snapshot file.
+		 * @param sourcePath Config file the snapshot was taken from. When given, a snapshot whose recorded hash does not match the file is rejected.
+		 * @return NO_ERROR, a file error, FILE_FORMAT_ERROR for a corrupt or foreign file or FILE_OUTDATED for a stale snapshot.
+		 */
+		ConfigError load(const std::string& snapshotPath, const std::string& sourcePath = "") {
+			*this = ConfigSnapshot();
+			std::string buffer;
+			ConfigError error = readFileBuffer(snapshotPath, buffer);
+			if (error == ConfigError::NO_ERROR) {
+				error = loadFromBuffer(std::move(buffer));
+			}
+			if (error != ConfigError::NO_ERROR) {
+				return error;
+			}
+			if (!sourcePath.empty()) {
+				std::string sourceData;
+				error = readFileBuffer(sourcePath, sourceData);
+				if (error != ConfigError::NO_ERROR || hashBytes(sourceData) != sourceHash) {
+					data.clear();
+					return (error != ConfigError::NO_ERROR) ? error : ConfigError::FILE_OUTDATED;
+				}
+			}
+			return ConfigError::NO_ERROR;
+		}
+
+		/**
+		 * @brief Loads a snapshot already in memory, such as one returned by serialize().
+		 * @return NO_ERROR, or FILE_FORMAT_ERROR for a corrupt or foreign buffer.
+		 */
+		ConfigError loadFromBuffer(std::string buffer) {
+			*this = ConfigSnapshot();
+			data = std::move(buffer);
+			if (!validate()) {
+				data.clear();
+				return ConfigError::FILE_FORMAT_ERROR;
+			}
+			return ConfigError::NO_ERROR;
+		}
+
+		bool isLoaded() const { return !data.empty(); } //< Checks if a valid snapshot is loaded.
+		std::uint64_t getSourceHash() const { return sourceHash; } //< Hash of the source file recorded in the snapshot.
+		std::size_t size() const { return sectionCount; } //< Number of sections, an INI snapshot has a single unnamed one.
+		std::string_view sectionName(std::size_t index) const { return string(read32(sectionsOffset() + index * sectionSize), read32(sectionsOffset() + index * sectionSize + 4)); } //< Name of the section at index.
+
+		/**
+		 * @brief Looks a value up.
+		 * @param sectionName Section name, empty for INI snapshots.
+		 * @param key Key to look up.
+		 * @return View of the value in the snapshot, or nothing if the key does not exist.
+		 */
+		std::optional<std::string_view> get(std::string_view sectionName, std::string_view key) const {
+			if (slotCount == 0) {
+				return std::nullopt;
+			}
+			std::size_t mask = slotCount - 1;
+			for (std::size_t slot = entryHash(sectionName, key) & mask;; slot = (slot + 1) & mask) {
+				std::uint32_t index = read32(slotsOffset() + slot * 4);
+				if (index == 0) {
+					return std::nullopt;
+				}
+				std::size_t entry = entriesOffset() + (index - 1) * entrySize;
+				if (string(read32(entry + 4), read32(entry + 8)) == key && this->sectionName(read32(entry)) == sectionName) {
+					return string(read32(entry + 12), read32(entry + 16));
+				}
+			}
+		}
+
+		/**
+		 * @brief Writes a snapshot.
+		 * @param snapshotPath Destination file.
+		 * @param sections Section names and contents in order.
+		 * @param sourceHash Hash of the config file the document was loaded from, see hashBytes().
+		 */
+		static ConfigError write(const std::string& snapshotPath, const std::vector<std::pair<std::string_view, const ConfigSection*>>& sections, std::uint64_t sourceHash) {
+			return writeFileBuffer(snapshotPath, serialize(sections, sourceHash));
+		}
+
+		/**
+		 * @brief Builds the bytes of a snapshot, see write().
+		 */
+		static std::string serialize(const std::vector<std::pair<std::string_view, const ConfigSection*>>& sections, std::uint64_t sourceHash) {
+			std::string strings, sectionTable, entryTable;
+			std::vector<std::uint64_t> hashes;
+			auto addString = [&](std::string_view text, std::string& table) {
+				append32(table, static_cast<std::uint32_t>(strings.size()));
+				append32(table, static_cast<std::uint32_t>(text.size()));
+				strings.append(text);
+			};
+			for (std::size_t index = 0; index < sections.size(); index++) {
+				auto& [sectionName, section_] = sections[index];
+				addString(sectionName, sectionTable);
+				append32(sectionTable, static_cast<std::uint32_t>(hashes.size()));
+				std::size_t first = hashes.size();
+				for (auto& key : *section_) {
+					append32(entryTable, static_cast<std::uint32_t>(index));
+					addString(key, entryTable);
+					addString(static_cast<std::string>(section_->get(key)), entryTable);
+					hashes.push_back(entryHash(sectionName, key));
+				}
+				append32(sectionTable, static_cast<std::uint32_t>(hashes.size() - first));
+			}
+
+			std::size_t slots = 1;
+			while (slots <= hashes.size() * 2) {
+				slots *= 2;
+			}
+			std::vector<std::uint32_t> index(slots, 0);
+			for (std::size_t entry = 0; entry < hashes.size(); entry++) {
+				std::size_t slot = hashes[entry] & (slots - 1);
+				while (index[slot] != 0) {
+					slot = (slot + 1) & (slots - 1);
+				}
+				index[slot] = static_cast<std::uint32_t>(entry + 1);
+			}
+
+			std::string output("CPSN", 4);
+			append32(output, version);
+			append32(output, static_cast<std::uint32_t>(sourceHash));
+			append32(output, static_cast<std::uint32_t>(sourceHash >> 32));
+			append32(output, static_cast<std::uint32_t>(sections.size()));
+			append32(output, static_cast<std::uint32_t>(hashes.size()));
+			append32(output, static_cast<std::uint32_t>(slots));
+			append32(output, 0);
+			output += sectionTable;
+			output += entryTable;
+			for (auto slot : index) {
+				append32(output, slot);
+			}
+			output += strings;
+			return output;
+		}
+
+	private:
+		static constexpr std::size_t headerSize = 32;
+		static constexpr std::size_t sectionSize = 16;
+		static constexpr std::size_t entrySize = 20;
+
+		std::size_t sectionsOffset() const { return headerSize; }
+		std::size_t entriesOffset() const { return sectionsOffset() + sectionCount * sectionSize; }
+		std::size_t slotsOffset() const { return entriesOffset() + entryCount * entrySize; }
+		std::size_t stringsOffset() const { return slotsOffset() + slotCount * 4; }
+		std::string_view string(std::uint32_t offset, std::uint32_t length) const { return std::string_view(data).substr(stringsOffset() + offset, length); }
+
+		std::uint32_t read32(std::size_t offset) const {
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data()) + offset;
+			return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+		}
+
+		static void append32(std::string& output, std::uint32_t value) {
+			for (int shift = 0; shift < 32; shift += 8) {
+				output.push_back(static_cast<char>((value >> shift) & 0xff));
+			}
+		}
+
+		static std::uint64_t entryHash(std::string_view sectionName, std::string_view key) {
+			return hashBytes(key, hashBytes(std::string_view("\0", 1), hashBytes(sectionName)));
+		}
+
+		/**
+		 * @brief Checks the header and that every table entry lies inside the file, so lookups need no bounds checks.
+		 */
+		bool validate() {
+			if (data.size() < headerSize || data.compare(0, 4, "CPSN") != 0 || read32(4) != version) {
+				return false;
+			}
+			sourceHash = read32(8) | (static_cast<std::uint64_t>(read32(12)) << 32);
+			sectionCount = read32(16);
+			entryCount = read32(20);
+			slotCount = read32(24);
+			if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0 || slotCount <= entryCount ||
+				static_cast<std::uint64_t>(sectionCount) * sectionSize + static_cast<std::uint64_t>(entryCount) * entrySize + static_cast<std::uint64_t>(slotCount) * 4 > data.size() - headerSize) {
+				return false;
+			}
+			std::size_t stringsSize = data.size() - stringsOffset();
+			auto inStrings = [&](std::size_t offset) { return static_cast<std::uint64_t>(read32(offset)) + read32(offset + 4) <= stringsSize; };
+			for (std::size_t index = 0; index < sectionCount; index++) {
+				std::size_t section_ = sectionsOffset() + index * sectionSize;
+				if (!inStrings(section_) || static_cast<std::uint64_t>(read32(section_ + 8)) + read32(section_ + 12) > entryCount) {
+					return false;
+				}
+			}
+			for (std::size_t index = 0; index < entryCount; index++) {
+				std::size_t entry = entriesOffset() + index * entrySize;
+				if (read32(entry) >= sectionCount || !inStrings(entry + 4) || !inStrings(entry + 12)) {
+					return false;
+				}
+			}
+			// Lookups stop at the first empty slot, so a table without one would never terminate.
+			std::size_t used = 0;
+			for (std::size_t slot = 0; slot < slotCount; slot++) {
+				std::uint32_t index = read32(slotsOffset() + slot * 4);
+				if (index > entryCount) {
+					return false;
+				}
+				used += (index != 0);
+			}
+			return used <= entryCount;
+		}
+
+		std::string data;
+		std::size_t sectionCount;
+		std::size_t entryCount;
+		std::size_t slotCount;
+		std::uint64_t sourceHash;
+	};
+
+	/**
+	* IniParser class
+	* @brief Ini config file type parser, inherits from both ConfigSection and Parser classes.
+	*/
+	class IniParser : public Parser, public ConfigSection {
+	public:
+		IniParser(std::string _path = "") :
+			Parser(_path) {
+			readFile();
+		}
+		~IniParser() { this->erase(); }
+
+		/**
+		* @brief Function override from the ConfigSection class to handle line addition.
+		*/
+		template<typename value_type>
+		void insert(std::string_view key, value_type value) {
+			if (!dict.contains(key)) {
+				appendLine(ConfigType::CONFIG_VALUE, key);
+				ConfigSection::insert(key,value);
+			}
+		}
+
+		/**
+* @brief Function override from the ConfigSection class to handle line removal.
+*/
+		virtual ConfigValue pop(std::string_view key) override {
+			if (dict.contains(key)) {
+				removeLine(key);
+			}
+			return ConfigSection::pop(key);
+		}
+
+		/**
+* @brief Function override from the ConfigSection class to handle line removal.
+*/
+		virtual void remove(std::string_view key) override {
+			if (dict.contains(key)) {
+				removeLine(key);
+				ConfigSection::remove(key);
+			}
+		}
+
+		virtual ConfigValue& operator[](std::string_view key) override {
+			if (!dict.contains(key)) {
+				appendLine(ConfigType::CONFIG_VALUE, key);
+			}
+			return ConfigSection::operator[](key);
+		}
+		/**
+		* @brief erases all keys and values.
+		*/
+		virtual void clear() override {
+			ConfigSection::clear();
+			Parser::erase();
+		}
+
+		/**
+		* @brief Writes a binary snapshot of the document, see ConfigSnapshot. Take it right after load() or save() so it matches the file.
+		*/
+		ConfigError saveSnapshot(const std::string& snapshotPath) {
+			return ConfigSnapshot::write(snapshotPath, snapshotSections(), sourceHash());
+		}
+
+		/**
+		* @brief Gets the document as ConfigSnapshot expects it, a single unnamed section.
+		*/
+		std::vector<std::pair<std::string_view, const ConfigSection*>> snapshotSections() { return { { std::string_view(), this } }; }
+
+		/**
+		* @brief Reloads the file. Nothing is reparsed if the file is byte for byte unchanged and no value was modified since the last load.
+		*/
+		virtual void reload() override {
+			changes.clear();
+			std::string buffer;
+			if (!readBuffer(buffer)) {
+				return;
+			}
+			if (!modified && !source.empty() && buffer == source) {
+				return;
+			}
+			ConfigSection before(std::move(static_cast<ConfigSection&>(*this)));
+			clear();
+			source = arena.adopt(std::move(buffer));
+			parse(source);
+			diffSection("", before, *this, changes);
+		}
+
+	protected:
+		//< Parse function implementation
+		virtual void parse(std::string_view buffer) override {
+			Lexer lexer(buffer);
+			ConfigToken token;
+			while (lexer.next(token)) {
+				if (token.type == ConfigType::CONFIG_COMMENT || token.type == ConfigType::CONFIG_EMPTY_LINE) {
+					appendParsedLine(token.type, token.key, token.line);
+				}
+				else if (token.type == ConfigType::CONFIG_VALUE && !dict.contains(token.key)) {
+					appendParsedLine(ConfigType::CONFIG_VALUE, token.key, token.line);
+					ConfigSection::insert(token.key, std::string(token.value));
+				}
+			}
+			modified = false;
+		}
+
+		/**
+		* @brief Serializes the document into output.
+		* Lines are copied as they were loaded, only the lines of keys handed out for writing and the lines added since are formatted.
+		*/
+		virtual void serialize(std::string& output) override {
+			output.reserve(output.size() + serializedSizeHint());
+			std::unordered_set<std::string_view> changed(dict.changedKeys().begin(), dict.changedKeys().end());
+			for (auto& line : lines) {
+				if (!line.text.empty() && (changed.empty() || line.type != ConfigType::CONFIG_VALUE || !changed.contains(line.content))) {
+					appendLoaded(output, line.text);
+				}
+				else if (line.type == ConfigType::CONFIG_EMPTY_LINE || line.type == ConfigType::CONFIG_COMMENT) {
+					output += line.content;
+					output += '\n';
+				}
+				else if (line.type == ConfigType::CONFIG_VALUE) {
+					const ConfigValue* value = dict.find(line.content);
+					if (isUnchanged(line, *value)) {
+						appendLoaded(output, line.text);
+					}
+					else {
+						output += line.content;
+						output += " = ";
+						value->appendTo(output);
+						output += '\n';
+					}
+				}
+			}
+		}
+
+		//< Erase function implementation
+		virtual void erase() override {
+			clear();
+		}
+	};
+
+
+	/**
+	* @class CfgParser class
+ * @brief CFG file type  Parser, inherits from Parser class.
+ * Provides functionality for  and removing sections. Each section is a ConfigSection class which provides acces to it's values.
+ * It is also possibel to loop through class sections as with values.
+ */
+	class CfgParser : public Parser {
+	private:
+		StringVector keys;
+		SectionMap _sections;
+		bool lazy;
+		unsigned threads;
+		std::unordered_map<std::string, std::vector<std::string_view>, StringHash, std::equal_to<>> pending; //< Unparsed section bodies in lazy mode, viewing the arena.
+		std::unordered_map<std::string, LineVector, StringHash, std::equal_to<>> parsed; //< Lines of sections parsed in lazy mode, not yet spliced into lines, see spliceParsed().
+
+	public:
+		/**
+		 * @brief Constructor.
+		 * @param _path Path to the configuration file.
+		 * @param _lazy Only index section names at load, parse a section's keys on first access.
+		 */
+		CfgParser(std::string _path = "", bool _lazy = false) : Parser(_path, ConfigType::CONFIG_SECTION), lazy(_lazy), threads(1) {
+			readFile();
+		}
+
+		/**
+		 * @brief Destructor.
+		 */
+		~CfgParser() {
+			clear();
+			erase();
+		}
+
+		/**
+		 * @brief Adds a new section.
+		 * @param sectionName Name of the section to add.
+		 */
+		void addSection(std::string sectionName) {
+			if (!_sections.contains(sectionName)) {
+				if (!lines.empty() && lastLineType() != ConfigType::CONFIG_EMPTY_LINE) {
+					appendLine(ConfigType::CONFIG_EMPTY_LINE, "");
+				}
+				insertSection(sectionName);
+			}
+		}
+
+		/**
+		 * @brief Removes a section.
+		 * @param sectionName Name of the section to remove.
+		 */
+		void removeSection(std::string_view sectionName) {
+			auto iter = _sections.find(sectionName);
+			if (iter != _sections.end()) {
+				removeElement(keys, sectionName);
+				removeSectionLines(sectionName);
+				_sections.erase(iter);
+				auto node = pending.find(sectionName);
+				if (node != pending.end()) {
+					pending.erase(node);
+				}
+				auto body = parsed.find(sectionName);
+				if (body != parsed.end()) {
+					parsed.erase(body);
+				}
+			}
+		}
+
+		/**
+		 * @brief Retrieves a section.
+		 * @param sectionName Name of the section to retrieve.
+		 * @return Reference to the ConfigSection.
+		 * @throw std::out_of_range if section not found.
+		 */
+		ConfigSection& section(std::string_view sectionName) {
+			auto iter = _sections.find(sectionName);
+			if (iter != _sections.end()) {
+				if (!pending.empty()) {
+					loadSection(sectionName);
+				}
+				return iter->second;
+			}
+			else {
+				CONFIGPARSER_THROW(std::out_of_range("Section not found: " + std::string(sectionName)));
+			}
+		}
+
+		/**
+		 * @brief Gets all section names.
+		 * @return Vector of section names.
+		 */
+		const StringVector& sections() { return keys; }
+
+		/**
+		 * @brief Checks if a section exists.
+		 */
+		bool hasSection(std::string_view sectionName) const { return _sections.contains(sectionName); }
+
+		/**
+		 * @brief Gets a value converted to value_type, without throwing.
+		 * @return The value, or nothing if the section or key doesn't exist or the value is not convertible.
+		 */
+		template<typename value_type>
+		std::optional<value_type> tryGet(std::string_view sectionName, std::string_view key) {
+			auto iter = _sections.find(sectionName);
+			if (iter == _sections.end()) {
+				return std::nullopt;
+			}
+			if (!pending.empty()) {
+				loadSection(sectionName);
+			}
+			return iter->second.tryGet<value_type>(key);
+		}
+
+		/**
+		 * @brief Gets a value converted to value_type, or fallback if it is missing or not convertible. Never throws.
+		 */
+		template<typename value_type>
+		value_type getOr(std::string_view sectionName, std::string_view key, value_type fallback) {
+			auto iter = _sections.find(sectionName);
+			if (iter == _sections.end()) {
+				return fallback;
+			}
+			if (!pending.empty()) {
+				loadSection(sectionName);
+			}
+			return iter->second.getOr<value_type>(key, std::move(fallback));
+		}
+
+		/**
+		 * @brief Writes a binary snapshot of the document, see ConfigSnapshot. Take it right after load() or save() so it matches the file.
+		 */
+		ConfigError saveSnapshot(const std::string& snapshotPath) {
+			return ConfigSnapshot::write(snapshotPath, snapshotSections(), sourceHash());
+		}
+
+		/**
+		 * @brief Gets the sections in order as ConfigSnapshot expects them. Parses pending sections in lazy mode.
+		 */
+		std::vector<std::pair<std::string_view, const ConfigSection*>> snapshotSections() {
+			std::vector<std::pair<std::string_view, const ConfigSection*>> sections_;
+			for (auto& sectionName : keys) {
+				sections_.emplace_back(sectionName, &section(sectionName));
+			}
+			return sections_;
+		}
+
+		using Parser::load;
+
+		/**
+		 * @brief Loads a config file, parsing it on several threads.
+		 * @param _path File path.
+		 * @param threadCount Number of parser threads, see setThreads().
+		 */
+		void load(std::string _path, unsigned threadCount) {
+			setThreads(threadCount);
+			load(_path);
+		}
+
+		/**
+		 * @brief Enables or disables lazy section parsing for subsequent loads.
+		 */
+		void setLazy(bool _lazy) { lazy = _lazy; }
+
+		/**
+		 * @brief Sets the number of threads used to parse subsequent loads, 0 uses one per hardware thread.
+		 * The file is split at section headers and the chunks are parsed concurrently, then merged in file order. Ignored in lazy mode.
+		 */
+		void setThreads(unsigned threadCount) { threads = (threadCount == 0) ? std::max(1u, std::thread::hardware_concurrency()) : threadCount; }
+
+		/**
+		 * @brief Checks if a section's keys have been parsed. Always true outside lazy mode.
+		 */
+		bool isLoaded(std::string_view sectionName) const { return !pending.contains(sectionName); }
+
+		/**
+		 * @brief Clears all sections and parser data.
+		 */
+		void clear() {
+			keys.clear();
+			_sections.clear();
+			pending.clear();
+			parsed.clear();
+			Parser::erase();
+		}
+
+		ConfigSection& operator[](std::string_view sectionName) { return section(sectionName); }
+
+		KeysIter begin() { return keys.begin(); }
+		KeysIter end() { return keys.end(); }
+		ConstKeysIter cbegin() { return keys.cbegin(); }
+		ConstKeysIter cend() { return keys.cend(); }
+
+	protected:
+		/**
+		 * @brief Registers a section and its line, returning the existing section if it is already known.
+		 * @param text Header line as loaded. A loaded header repeating a known section marks it modified, its keys are written back under the first header.
+		 */
+		ConfigSection& insertSection(const std::string& sectionName, std::string_view text = {}) {
+			auto [iter, inserted] = _sections.try_emplace(sectionName);
+			if (inserted) {
+				keys.push_back(sectionName);
+				appendLine(ConfigType::CONFIG_SECTION, sectionName);
+				lines.back().text = text;
+			}
+			else if (!text.empty()) {
+				iter->second.modified = true;
+			}
+			return iter->second;
+		}
+
+		/**
+		 * @brief Removes a section line together with every line up to the next section.
+		 */
+		void removeSectionLines(std::string_view sectionName) {
+			std::size_t first = findLine(sectionName);
+			if (first < lines.size()) {
+				std::size_t last = first + 1;
+				while (last < lines.size() && lines[last].type != ConfigType::CONFIG_SECTION) {
+					last++;
+				}
+				removeLines(first, last);
+			}
+		}
+
+		/**
+		 * @brief Index of the last value line belonging to the section that starts at index, or index itself if it has none.
+		 */
+		std::size_t lastValueLine(std::size_t index) const {
+			std::size_t last = index;
+			for (std::size_t next = index + 1; next < lines.size() && lines[next].type != ConfigType::CONFIG_SECTION; next++) {
+				if (lines[next].type == ConfigType::CONFIG_VALUE) {
+					last = next;
+				}
+			}
+			return last;
+		}
+
+		/**
+		 * @brief Stores a comment, empty line or value token into a section, appending its line to target.
+		 * A repeated key overwrites the value and marks the section modified, as its first line no longer holds the value.
+		 * @param repeated The token follows a repeated section header, its line ends up in another section's block and is stored without its loaded text.
+		 */
+		static void parseToken(const ConfigToken& token, ConfigSection* section_, LineVector& target, bool repeated = false) {
+			std::string_view text = repeated ? std::string_view() : token.line;
+			if (token.type == ConfigType::CONFIG_COMMENT || token.type == ConfigType::CONFIG_EMPTY_LINE) {
+				target.push_back({ token.type, token.key, text });
+			}
+			else if (token.type == ConfigType::CONFIG_VALUE && section_) {
+				auto [value, inserted] = section_->dict.tryEmplace(token.key, std::string(token.value));
+				if (inserted) {
+					target.push_back({ ConfigType::CONFIG_VALUE, token.key, text });
+				}
+				else {
+					*value = std::string(token.value);
+					section_->modified = true;
+				}
+			}
+		}
+
+		/**
+		 * @brief Parses the configuration buffer.
+		 * In lazy mode only section headers are tokenized, each section body is recorded for loadSection().
+		 */
+		virtual void parse(std::string_view buffer) override {
+			if (!lazy && threads > 1) {
+				parseParallel(buffer);
+			}
+			else {
+				Lexer lexer(buffer);
+				ConfigToken token;
+				ConfigSection* section_ = nullptr;
+				bool repeated = false;
+				while (lexer.next(token)) {
+					if (token.type == ConfigType::CONFIG_SECTION) {
+						repeated = _sections.contains(token.key);
+						section_ = &insertSection(std::string(token.key), token.line);
+						if (lazy) {
+							std::size_t end = lexer.findSection(lexer.offset());
+							pending[std::string(token.key)].push_back(buffer.substr(lexer.offset(), end - lexer.offset()));
+							lexer.seek(end);
+						}
+					}
+					else {
+						parseToken(token, section_, lines, repeated);
+					}
+				}
+			}
+		}
+
+		/**
+		 * @struct SectionRange struct
+		 * @brief A section header name, the bytes of its body and of its header line, all viewing the scanned buffer.
+		 */
+		struct SectionRange {
+			std::string_view name;
+			std::string_view body;
+			std::string_view header;
+		};
+
+		/**
+		 * @brief Lists the sections of a buffer in file order without tokenizing their bodies.
+		 * @param buffer Buffer to scan.
+		 * @param preamble Receives the text before the first section.
+		 */
+		static std::vector<SectionRange> scanSections(std::string_view buffer, std::string_view& preamble) {
+			std::vector<SectionRange> ranges;
+			Lexer lexer(buffer);
+			ConfigToken token;
+			std::size_t start = lexer.findSection(0);
+			preamble = buffer.substr(0, start);
+			while (start < buffer.size()) {
+				lexer.seek(start);
+				lexer.next(token);
+				std::size_t end = lexer.findSection(lexer.offset());
+				ranges.push_back({ token.key, buffer.substr(lexer.offset(), end - lexer.offset()), token.line });
+				start = end;
+			}
+			return ranges;
+		}
+
+		/**
+		 * @brief Sections and lines parsed from one chunk of the buffer by a worker thread.
+		 */
+		struct ParsedChunk {
+			LineVector lines;
+			StringVector keys;
+			SectionMap sections;
+		};
+
+		/**
+		 * @brief Parses one chunk into thread local storage. Section lines view the buffer, so the arena is not touched.
+		 */
+		static void parseChunk(std::string_view chunk, ParsedChunk& result) {
+			Lexer lexer(chunk);
+			ConfigToken token;
+			ConfigSection* section_ = nullptr;
+			bool repeated = false;
+			while (lexer.next(token)) {
+				if (token.type == ConfigType::CONFIG_SECTION) {
+					auto [iter, inserted] = result.sections.try_emplace(std::string(token.key));
+					if (inserted) {
+						result.keys.push_back(iter->first);
+						result.lines.push_back({ ConfigType::CONFIG_SECTION, token.key, token.line });
+					}
+					else {
+						iter->second.modified = true;
+					}
+					repeated = !inserted;
+					section_ = &iter->second;
+				}
+				else {
+					parseToken(token, section_, result.lines, repeated);
+				}
+			}
+		}
+
+		/**
+		 * @brief Splits the buffer at section headers into one chunk per thread, parses the chunks concurrently and merges them in file order.
+		 */
+		void parseParallel(std::string_view buffer) {
+			constexpr std::size_t minChunkSize = 64 * 1024;
+			Lexer lexer(buffer);
+			std::vector<std::string_view> chunks;
+			std::size_t chunkSize = std::max(buffer.size() / threads, minChunkSize);
+			for (std::size_t start = 0; start < buffer.size();) {
+				std::size_t end = std::min(start + chunkSize, buffer.size());
+				end = buffer.find('\n', end);
+				end = lexer.findSection((end == std::string_view::npos) ? buffer.size() : end + 1);
+				chunks.push_back(buffer.substr(start, end - start));
+				start = end;
+			}
+
+			std::vector<ParsedChunk> results(chunks.size());
+			std::vector<std::thread> workers;
+			for (std::size_t index = 1; index < chunks.size(); index++) {
+				workers.emplace_back(parseChunk, chunks[index], std::ref(results[index]));
+			}
+			if (!chunks.empty()) {
+				parseChunk(chunks[0], results[0]);
+			}
+			for (auto& worker : workers) {
+				worker.join();
+			}
+
+			for (auto& result : results) {
+				// A header repeated from an earlier chunk merges into that section, as it would when parsed serially.
+				bool repeated = false;
+				for (auto& line : result.lines) {
+					if (line.type == ConfigType::CONFIG_SECTION) {
+						repeated = _sections.contains(line.content);
+						if (!repeated) {
+							lines.push_back(line);
+						}
+					}
+					else {
+						lines.push_back({ line.type, line.content, repeated ? std::string_view() : line.text });
+					}
+				}
+				for (auto& sectionName : result.keys) {
+					ConfigSection& local = result.sections[sectionName];
+					auto [iter, inserted] = _sections.try_emplace(sectionName, std::move(local));
+					if (inserted) {
+						keys.push_back(sectionName);
+					}
+					else {
+						for (auto& key : local) {
+							iter->second[key] = local.get(key);
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Parses the recorded body of a lazily loaded section. Its lines are kept aside until spliceParsed(), so a first access costs only the section's size.
+		 */
+		void loadSection(std::string_view sectionName) {
+			auto node = pending.find(sectionName);
+			if (node == pending.end()) {
+				return;
+			}
+			auto bodies = std::move(node->second);
+			pending.erase(node);
+
+			ConfigSection& section_ = _sections.find(sectionName)->second;
+			LineVector body;
+			ConfigToken token;
+			for (auto& text : bodies) {
+				Lexer lexer(text);
+				while (lexer.next(token)) {
+					parseToken(token, &section_, body);
+				}
+			}
+			parsed.try_emplace(std::string(sectionName), std::move(body));
+		}
+
+		/**
+		 * @brief Type of the last line of the document, including the lines of a last section that were not spliced yet. lines must not be empty.
+		 */
+		ConfigType lastLineType() const {
+			if (lines.back().type == ConfigType::CONFIG_SECTION) {
+				auto body = parsed.find(lines.back().content);
+				if (body != parsed.end() && !body->second.empty()) {
+					return body->second.back().type;
+				}
+			}
+			return lines.back().type;
+		}
+
+		/**
+		 * @brief Moves the lines of parsed sections after their section headers, rebuilding lines once for all of them.
+		 */
+		void spliceParsed() {
+			if (parsed.empty()) {
+				return;
+			}
+			std::size_t size = lines.size();
+			for (auto& [sectionName, body] : parsed) {
+				size += body.size();
+			}
+			LineVector spliced;
+			spliced.reserve(size);
+			for (auto& line : lines) {
+				spliced.push_back(line);
+				if (line.type == ConfigType::CONFIG_SECTION) {
+					// Only the first header of a section gets its lines, like the keys of repeated headers in an eager load.
+					auto body = parsed.find(line.content);
+					if (body != parsed.end()) {
+						spliced.insert(spliced.end(), body->second.begin(), body->second.end());
+						parsed.erase(body);
+					}
+				}
+			}
+			parsed.clear();
+			lines = std::move(spliced);
+			resetLineIndex();
+		}
+
+	public:
+		/**
+		 * @brief Reloads the file, reparsing only the sections whose bytes changed on disk.
+		 * A section is kept as is, with its storage, when its body is byte for byte identical to the previous load and it was not modified since.
+		 * The differences are reported through getChanges(). Lazy loads and files with repeated section headers are reparsed in full. In lazy mode, sections that were not parsed before the reload are only reported when added or removed.
+		 */
+		virtual void reload() override {
+			changes.clear();
+			std::string buffer;
+			if (!readBuffer(buffer)) {
+				return;
+			}
+			TextArena previousArena = std::move(arena);
+			arena = TextArena();
+			std::string_view previousSource = source;
+			SectionMap previous = std::move(_sections);
+			LineVector previousLines = std::move(lines);
+			bool incremental = !lazy && pending.empty() && !previousSource.empty();
+			auto previousPending = std::move(pending);
+			_sections.clear();
+			lines.clear();
+			resetLineIndex();
+			keys.clear();
+			pending.clear();
+			parsed.clear();
+			source = arena.adopt(std::move(buffer));
+
+			std::string_view preamble, previousPreamble;
+			std::vector<SectionRange> ranges = scanSections(source, preamble);
+			std::unordered_map<std::string_view, std::string_view> previousBodies;
+			std::unordered_set<std::string_view> repeated;
+			if (incremental) {
+				for (auto& range : scanSections(previousSource, previousPreamble)) {
+					if (!previousBodies.try_emplace(range.name, range.body).second) {
+						repeated.insert(range.name);
+					}
+				}
+				std::unordered_set<std::string_view> seen;
+				for (auto& range : ranges) {
+					if (!seen.insert(range.name).second) {
+						repeated.insert(range.name);
+					}
+				}
+			}
+
+			std::unordered_set<std::string> kept;
+			if (!incremental) {
+				parse(source);
+			}
+			else {
+				// Line ranges of every section in the previous document, to copy the lines of kept sections.
+				std::unordered_map<std::string_view, std::pair<std::size_t, std::size_t>> previousBlocks;
+				for (std::size_t index = 0, start = previousLines.size(); index <= previousLines.size(); index++) {
+					if (index == previousLines.size() || previousLines[index].type == ConfigType::CONFIG_SECTION) {
+						if (start < index) {
+							previousBlocks.try_emplace(previousLines[start].content, start + 1, index);
+						}
+						start = index;
+					}
+				}
+
+				Lexer lexer(preamble);
+				ConfigToken token;
+				while (lexer.next(token)) {
+					parseToken(token, nullptr, lines);
+				}
+				for (auto& range : ranges) {
+					std::string sectionName(range.name);
+					auto before = previous.find(sectionName);
+					auto body = previousBodies.find(range.name);
+					auto block = previousBlocks.find(range.name);
+					if (!repeated.contains(range.name) && before != previous.end() && !before->second.modified &&
+						body != previousBodies.end() && body->second == range.body && block != previousBlocks.end()) {
+						insertSection(sectionName, range.header) = std::move(before->second);
+						for (std::size_t index = block->second.first; index < block->second.second; index++) {
+							const ConfigLine& line = previousLines[index];
+							if (line.type != ConfigType::CONFIG_REMOVED) {
+								lines.push_back({ line.type, rebase(line.content, body->second, range.body), rebase(line.text, body->second, range.body) });
+							}
+						}
+						kept.insert(sectionName);
+					}
+					else {
+						bool repeatedHeader = _sections.contains(range.name);
+						ConfigSection* section_ = &insertSection(sectionName, range.header);
+						Lexer bodyLexer(range.body);
+						while (bodyLexer.next(token)) {
+							parseToken(token, section_, lines, repeatedHeader);
+						}
+					}
+				}
+			}
+
+			for (auto& sectionName : keys) {
+				// A section that was never parsed has no keys to compare, one that was is parsed again to be compared.
+				if (kept.contains(sectionName) || previousPending.contains(sectionName)) {
+					continue;
+				}
+				loadSection(sectionName);
+				ConfigSection& section_ = _sections[sectionName];
+				auto before = previous.find(sectionName);
+				if (before == previous.end()) {
+					changes.push_back({ ChangeType::ADDED, sectionName, "" });
+				}
+				else {
+					diffSection(sectionName, before->second, section_, changes);
+				}
+			}
+			for (auto& [sectionName, section_] : previous) {
+				if (!_sections.contains(sectionName)) {
+					changes.push_back({ ChangeType::REMOVED, sectionName, "" });
+				}
+			}
+		}
+
+		/**
+		 * @brief Serializes the configuration into output.
+		 * Unmodified sections are copied as they were loaded. In modified sections only the lines whose value differs from the file are formatted.
+		 */
+		virtual void serialize(std::string& output) override {
+			for (auto& sectionName : keys) {
+				loadSection(sectionName);
+			}
+			spliceParsed();
+			output.reserve(output.size() + serializedSizeHint());
+			const ConfigSection* section_ = nullptr;
+			std::unordered_set<std::string_view> written;
+			std::size_t flushAt = lines.size();
+			auto appendValue = [&](std::string_view key, const ConfigValue& value) {
+				output += key;
+				output += " = ";
+				value.appendTo(output);
+				output += '\n';
+			};
+			for (std::size_t index = 0; index < lines.size(); index++) {
+				auto& line = lines[index];
+				if (line.type == ConfigType::CONFIG_SECTION) {
+					section_ = &_sections.find(line.content)->second;
+					written.clear();
+					flushAt = section_->modified ? lastValueLine(index) : lines.size();
+				}
+				if (line.type == ConfigType::CONFIG_REMOVED) {
+					continue;
+				}
+				if (!line.text.empty() && (line.type != ConfigType::CONFIG_VALUE || !section_->modified)) {
+					appendLoaded(output, line.text);
+				}
+				else if (line.type == ConfigType::CONFIG_EMPTY_LINE || line.type == ConfigType::CONFIG_COMMENT) {
+					output += line.content;
+					output += '\n';
+				}
+				else if (line.type == ConfigType::CONFIG_SECTION) {
+					output += '[';
+					output += line.content;
+					output += "]\n";
+				}
+				// Value lines without loaded text in an unmodified section follow a repeated header, their keys belong to another section.
+				else if (line.type == ConfigType::CONFIG_VALUE && section_ && section_->modified) {
+					const ConfigValue* value = section_->dict.find(line.content);
+					if (value && written.insert(line.content).second) {
+						if (isUnchanged(line, *value)) {
+							appendLoaded(output, line.text);
+						}
+						else {
+							appendValue(line.content, *value);
+						}
+					}
+				}
+				// Keys added since the file was loaded follow the section's last value line.
+				if (index == flushAt) {
+					for (auto& key : *section_) {
+						if (!written.contains(key)) {
+							appendValue(key, *section_->dict.find(key));
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Erases all data.
+		 */
+		virtual void erase() override {
+			clear();
+		}
+	};
+
+	/**
+	* @class ConfigSet class
+	* @brief Loads every INI and CFG file of a conf.d style directory concurrently.
+	* Files are ordered by path, so lookups that go through several files resolve the same way on every run.
+	*/
+	class ConfigSet {
+	public:
+		/**
+		 * @brief Constructor.
+		 * @param threadCount Number of loader threads, 0 uses one per hardware thread.
+		 */
+		ConfigSet(unsigned threadCount = 0) :
+			threads((threadCount == 0) ? std::max(1u, std::thread::hardware_concurrency()) : threadCount) {}
+
+		/**
+		 * @brief Loads all .ini and .cfg files matching a directory or a glob, replacing the current set.
+		 * @param pattern A directory, or a directory followed by a file name pattern using '*' and '?', such as "conf.d/app-*.cfg".
+		 * @return FILE_NOT_FOUND if the directory does not exist, otherwise NO_ERROR. Errors of single files are reported by getError(file).
+		 */
+		ConfigError load(const std::string& pattern) {
+			clear();
+			std::error_code error;
+			std::filesystem::path directory(pattern), filePattern("*");
+			if (!std::filesystem::is_directory(directory, error)) {
+				// A last component without wildcards that does not exist names a missing directory, not a pattern.
+				filePattern = directory.filename();
+				if (filePattern.string().find_first_of("*?") == std::string::npos && !std::filesystem::exists(directory, error)) {
+					return ConfigError::FILE_NOT_FOUND;
+				}
+				directory = directory.parent_path();
+				if (directory.empty()) {
+					directory = ".";
+				}
+			}
+			std::filesystem::directory_iterator iter(directory, error);
+			if (error) {
+				return ConfigError::FILE_NOT_FOUND;
+			}
+			for (; !error && iter != std::filesystem::directory_iterator(); iter.increment(error)) {
+				auto extension = iter->path().extension();
+				std::error_code fileError;
+				if (iter->is_regular_file(fileError) && (extension == ".ini" || extension == ".cfg") && matches(iter->path().filename().string(), filePattern.string())) {
+					paths.push_back(iter->path().string());
+				}
+			}
+			std::sort(paths.begin(), paths.end());
+
+			// Workers claim the next file from a shared cursor, so threads that get small files simply take more of them.
+			entries.resize(paths.size());
+			std::atomic<std::size_t> cursor(0);
+			auto worker = [&] {
+				for (std::size_t index = cursor++; index < paths.size(); index = cursor++) {
+					Entry& entry = entries[index];
+					if (std::filesystem::path(paths[index]).extension() == ".ini") {
+						entry.ini = std::make_unique<IniParser>(paths[index]);
+						entry.error = entry.ini->getError();
+					}
+					else {
+						entry.cfg = std::make_unique<CfgParser>(paths[index]);
+						entry.error = entry.cfg->getError();
+					}
+				}
+			};
+			std::vector<std::thread> workers;
+			for (unsigned index = 1; index < std::min<std::size_t>(threads, paths.size()); index++) {
+				workers.emplace_back(worker);
+			}
+			worker();
+			for (auto& thread : workers) {
+				thread.join();
+			}
+			return ConfigError::NO_ERROR;
+		}
+
+		/**
+		 * @brief Gets the loaded file paths in merge order.
+		 */
+		const StringVector& files() const { return paths; }
+
+		/**
+		 * @brief Gets the error state of a loaded file, FILE_NOT_FOUND if the file is not part of the set.
+		 */
+		ConfigError getError(const std::string& file) const {
+			auto index = indexOf(file);
+			return (index != -1) ? entries[index].error : ConfigError::FILE_NOT_FOUND;
+		}
+
+		/**
+		 * @brief Gets the parser of an INI file in the set, or nullptr.
+		 */
+		IniParser* ini(const std::string& file) {
+			auto index = indexOf(file);
+			return (index != -1) ? entries[index].ini.get() : nullptr;
 		}
 
 		/**
-		 * @brief Removes and returns the value associated with the key.
-		 * @param key The key to remove.
-		 * @return The value associated with the key.
+		 * @brief Gets the parser of a CFG file in the set, or nullptr.
 		 */
-		virtual ConfigValue pop(const std::string& key) {
-			auto node = dict.extract(key);
-			ConfigValue value = node.mapped();
-			removeElement(keys, key);
-			node._Release();
-			return value;
+		CfgParser* cfg(const std::string& file) {
+			auto index = indexOf(file);
+			return (index != -1) ? entries[index].cfg.get() : nullptr;
 		}
 
 		/**
-		 * @brief Removes a key-value pair.
-		 * @param key The key to remove.
+		 * @brief Looks a key up through all files, files later in merge order take precedence.
+		 * @param sectionName Section to search in CFG files, INI files are searched when it is empty.
+		 * @param key Key to look up.
+		 * @return The value, or nullptr if no file defines it.
 		 */
-		virtual void remove(const std::string& key) {
-			if (dict.contains(key)) {
-				removeElement(keys, key);
-				dict.erase(key);
+		const ConfigValue* lookup(std::string_view sectionName, std::string_view key) {
+			for (auto entry = entries.rbegin(); entry != entries.rend(); entry++) {
+				ConfigSection* section_ = nullptr;
+				if (entry->ini && sectionName.empty()) {
+					section_ = entry->ini.get();
+				}
+				else if (entry->cfg && !sectionName.empty() && entry->cfg->hasSection(sectionName)) {
+					section_ = &entry->cfg->section(sectionName);
+				}
+				if (section_ && section_->exists(key)) {
+					return &static_cast<const ConfigSection*>(section_)->get(key);
+				}
 			}
+			return nullptr;
 		}
 
 		/**
-		 * @brief Updates the value of an existing key.
-		 * @param key The key to update.
-		 * @param value The new value.
+		 * @brief Drops all loaded files.
 		 */
-		template<typename value_type>
-		void update(const std::string& key, value_type value) {
-			if (dict.contains(key)) {
-				dict[key] = value;
-			}
+		void clear() {
+			paths.clear();
+			entries.clear();
+		}
+
+	private:
+		struct Entry {
+			std::unique_ptr<IniParser> ini;
+			std::unique_ptr<CfgParser> cfg;
+			ConfigError error = ConfigError::NO_ERROR;
+		};
+
+		int indexOf(const std::string& file) const {
+			auto iter = std::lower_bound(paths.begin(), paths.end(), file);
+			return (iter != paths.end() && *iter == file) ? static_cast<int>(iter - paths.begin()) : -1;
 		}
 
 		/**
-		 * @brief Checks if a key exists.
-		 * @param key The key to check.
-		 * @return True if the key exists, false otherwise.
+		 * @brief Matches a file name against a pattern where '*' matches any run of characters and '?' a single one.
 		 */
-		bool exists(const std::string& key) { return dict.contains(key); }
+		static bool matches(std::string_view name, std::string_view pattern) {
+			std::size_t nameIndex = 0, patternIndex = 0, starIndex = std::string_view::npos, resumeIndex = 0;
+			while (nameIndex < name.size()) {
+				if (patternIndex < pattern.size() && (pattern[patternIndex] == '?' || pattern[patternIndex] == name[nameIndex])) {
+					nameIndex++;
+					patternIndex++;
+				}
+				else if (patternIndex < pattern.size() && pattern[patternIndex] == '*') {
+					starIndex = patternIndex++;
+					resumeIndex = nameIndex;
+				}
+				else if (starIndex != std::string_view::npos) {
+					patternIndex = starIndex + 1;
+					nameIndex = ++resumeIndex;
+				}
+				else {
+					return false;
+				}
+			}
+			while (patternIndex < pattern.size() && pattern[patternIndex] == '*') {
+				patternIndex++;
+			}
+			return patternIndex == pattern.size();
+		}
+
+		unsigned threads;
+		StringVector paths;
+		std::vector<Entry> entries;
+	};
 
+	/**
+	* @class ConfigCache class
+	* @brief On disk cache of parsed config files, keyed by a hash of the file contents.
+	*
+	* Entries are ConfigSnapshot files, so a hit costs reading and hashing the config plus reading the snapshot, with no parsing.
+	* Entries are written through writeFileBuffer(), so several processes may share a directory and never see a partial entry.
+	* When the directory grows past its size limit, the least recently used entries are removed, a hit refreshes an entry's modification time.
+	*/
+	class ConfigCache {
+	public:
 		/**
-		 * @brief Clears all key-value pairs.
+		 * @brief Constructor, creates the cache directory if needed.
+		 * @param _directory Cache directory.
+		 * @param _maxSize Size limit of all entries in bytes.
 		 */
-		virtual void clear() {
-			dict.clear();
-			keys.clear();
+		ConfigCache(std::string _directory, std::uintmax_t _maxSize = 64 * 1024 * 1024) :
+			directory(std::move(_directory)), maxSize(_maxSize), hitCount(0), missCount(0) {
+			std::error_code error;
+			std::filesystem::create_directories(directory, error);
 		}
 
 		/**
-		 * @brief Gets the value associated with a key.
-		 * @param key The key to look up.
-		 * @return The value associated with the key.
-		 * @throw std::out_of_range if the key doesn't exist.
+		 * @brief Loads a config file through the cache. Files ending in .ini are parsed as INI, everything else as CFG.
+		 * @param filePath Config file.
+		 * @param snapshot Receives the parsed file.
+		 * @return NO_ERROR or the error of reading the config file. Failing to store an entry is not an error, the file is just parsed again next time.
 		 */
-		ConfigValue& get(const std::string& key) {
-			if (dict.contains(key)) {
-				return dict[key];
+		ConfigError load(const std::string& filePath, ConfigSnapshot& snapshot) {
+			std::string buffer;
+			ConfigError error = readFileBuffer(filePath, buffer);
+			if (error != ConfigError::NO_ERROR) {
+				return error;
+			}
+			bool ini = std::filesystem::path(filePath).extension() == ".ini";
+			std::uint64_t hash = hashBytes(buffer);
+			std::filesystem::path entry = entryPath(hash, ini);
+
+			if (snapshot.load(entry.string()) == ConfigError::NO_ERROR && snapshot.getSourceHash() == hash) {
+				hitCount++;
+				std::error_code timeError;
+				std::filesystem::last_write_time(entry, std::filesystem::file_time_type::clock::now(), timeError);
+				return ConfigError::NO_ERROR;
+			}
+
+			missCount++;
+			std::string data;
+			if (ini) {
+				IniParser parser;
+				parser.loadFromBuffer(buffer);
+				data = ConfigSnapshot::serialize(parser.snapshotSections(), hash);
 			}
 			else {
-				throw std::out_of_range("Non existent key: " + key);
+				CfgParser parser;
+				parser.loadFromBuffer(buffer);
+				data = ConfigSnapshot::serialize(parser.snapshotSections(), hash);
 			}
+			store(entry, data);
+			return snapshot.loadFromBuffer(std::move(data));
 		}
 
-		virtual ConfigValue& operator[](std::string key) {
-			if (dict.contains(key)) {
-				return dict[key];
+		std::size_t hits() const { return hitCount; } //< Number of loads answered from the cache.
+		std::size_t misses() const { return missCount; } //< Number of loads that had to parse the file.
+		const std::string& getDirectory() const { return directory; } //< Gets the cache directory.
+
+		/**
+		 * @brief Removes the least recently used entries, temporary files included, until the cache fits its size limit.
+		 */
+		void prune() {
+			struct Entry {
+				std::filesystem::path path;
+				std::filesystem::file_time_type time;
+				std::uintmax_t size;
+			};
+			std::vector<Entry> entries;
+			std::uintmax_t total = 0;
+			std::error_code error;
+			for (std::filesystem::directory_iterator file(directory, error), end; !error && file != end; file.increment(error)) {
+				std::error_code fileError;
+				if (isEntryFile(file->path()) && file->is_regular_file(fileError)) {
+					Entry entry{ file->path(), file->last_write_time(fileError), file->file_size(fileError) };
+					if (!fileError) {
+						total += entry.size;
+						entries.push_back(std::move(entry));
+					}
+				}
 			}
-			else {
-				dict.emplace(key,ConfigValue(""));
-				keys.push_back(key);
-				return dict[key];
+			if (total <= maxSize) {
+				return;
+			}
+			std::sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right) { return left.time < right.time; });
+			for (auto& entry : entries) {
+				if (total <= maxSize) {
+					break;
+				}
+				// Another process may have removed the entry already, its size is gone either way.
+				std::filesystem::remove(entry.path, error);
+				total -= entry.size;
+			}
+		}
+
+		/**
+		 * @brief Removes every entry, temporary files of unfinished writes included.
+		 */
+		void clear() {
+			std::error_code error;
+			for (std::filesystem::directory_iterator file(directory, error), end; !error && file != end; file.increment(error)) {
+				if (isEntryFile(file->path())) {
+					std::error_code fileError;
+					std::filesystem::remove(file->path(), fileError);
+				}
 			}
 		}
 
+	private:
+		/**
+		 * @brief Checks if a file is an entry or the temporary file of one, named entry.<random>.tmp by writeFileBuffer().
+		 * Temporary files left by a crashed writer count toward the size limit and age out like entries.
+		 */
+		static bool isEntryFile(const std::filesystem::path& file) {
+			if (file.extension() == ".tmp") {
+				return file.filename().string().find(".cpsn.") != std::string::npos;
+			}
+			return file.extension() == ".cpsn";
+		}
 
-		KeysIter begin() { return keys.begin(); }
-		KeysIter end() { return keys.end(); }
-		ConstKeysIter begin() const { return keys.cbegin(); }
-		ConstKeysIter end() const { return keys.cend(); }
+		std::filesystem::path entryPath(std::uint64_t hash, bool ini) const {
+			static constexpr char digits[] = "0123456789abcdef";
+			std::string name(16, '0');
+			for (int index = 15; index >= 0; index--, hash >>= 4) {
+				name[index] = digits[hash & 0xf];
+			}
+			return std::filesystem::path(directory) / (name + (ini ? ".ini" : ".cfg") + ".cpsn");
+		}
 
-	protected:
-		ValueMap dict;
-		StringVector keys;
+		/**
+		 * @brief Writes an entry through writeFileBuffer() and prunes the cache once it is in place.
+		 */
+		void store(const std::filesystem::path& entry, const std::string& data) {
+			if (writeFileBuffer(entry.string(), data) == ConfigError::NO_ERROR) {
+				prune();
+			}
+		}
+
+		std::string directory;
+		std::uintmax_t maxSize;
+		std::atomic<std::size_t> hitCount;
+		std::atomic<std::size_t> missCount;
 	};
 
 	/**
-	* IniParser class
-	* @brief Ini config file type parser, inherits from both ConfigSection and Parser classes.
+	* @class AutoSaver class
+	* @brief Write-behind saving for a parser, so saving often does not block the calling thread on the disk.
+	*
+	* save() serializes the document on the calling thread and hands the text to a background writer. The writer waits for the debounce
+	* window that starts with the first unwritten save, then writes only the latest text, so a burst of saves costs a single write.
+	* flush() and the destructor write any pending text before returning. The writer never touches the parser, which must outlive
+	* the AutoSaver only for calls to save().
 	*/
-	class IniParser : public Parser, public ConfigSection {
+	class AutoSaver {
 	public:
-		IniParser(std::string _path = "") :
-			Parser(_path) {
-			readFile();
+		/**
+		 * @brief Constructor, starts the writer thread.
+		 * @param _parser Parser to save, only accessed by save() on the calling thread.
+		 * @param _debounce Longest time a save waits for newer ones before it is written.
+		 */
+		AutoSaver(Parser& _parser, std::chrono::milliseconds _debounce = std::chrono::milliseconds(250)) :
+			parser(_parser), debounce(_debounce), pending(false), writing(false), stopping(false), flushing(0), error(ConfigError::NO_ERROR), writeCount(0) {
+			writer = std::thread(&AutoSaver::run, this);
 		}
-		~IniParser() { this->erase(); }
 
 		/**
-		* @brief Function override from the ConfigSection class to handle line addition.
-		*/
-		template<typename value_type>
-		void insert(std::string key, value_type value) {
-			if (!dict.contains(key)) {
-				appendLine(ConfigType::CONFIG_VALUE, key);
-				ConfigSection::insert(key,value);
+		 * @brief Destructor, writes the pending text and stops the writer thread.
+		 */
+		~AutoSaver() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
 			}
+			wake.notify_all();
+			writer.join();
 		}
 
+		AutoSaver(const AutoSaver&) = delete;
+		AutoSaver& operator=(const AutoSaver&) = delete;
+
 		/**
-* @brief Function override from the ConfigSection class to handle line removal.
-*/
-		virtual ConfigValue pop(const std::string& key) override {
-			if (dict.contains(key)) {
-				removeLine(key);
+		 * @brief Serializes the document now and schedules writing it, replacing any text that was not written yet.
+		 * @param _path File path, the parser's path is used when empty.
+		 */
+		void save(std::string _path = "") {
+			std::string text = parser.saveToString();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pendingPath = _path.empty() ? parser.getPath() : std::move(_path);
+				pendingText = std::move(text);
+				if (!pending) {
+					pending = true;
+					deadline = std::chrono::steady_clock::now() + debounce;
+				}
 			}
-			return ConfigSection::pop(key);
+			wake.notify_all();
 		}
 
 		/**
-* @brief Function override from the ConfigSection class to handle line removal.
-*/
-		virtual void remove(const std::string& key) override {
-			if (dict.contains(key)) {
-				removeLine(key);
-				ConfigSection::remove(key);
-			}
+		 * @brief Writes the pending text without waiting for the debounce window and waits until it is on disk.
+		 * @return Error state of the last write.
+		 */
+		ConfigError flush() {
+			std::unique_lock<std::mutex> lock(mutex);
+			flushing++;
+			wake.notify_all();
+			done.wait(lock, [this] { return !pending && !writing; });
+			flushing--;
+			return error;
 		}
 
-		virtual ConfigValue& operator[](std::string key) override {
-			if (!dict.contains(key)) {
-				appendLine(ConfigType::CONFIG_VALUE, key);
-			}
-			return ConfigSection::operator[](key);
-		}
 		/**
-		* @brief erases all keys and values.
-		*/
-		virtual void clear() override {
-			ConfigSection::clear();
-			Parser::erase();
+		 * @brief Error state of the last write.
+		 */
+		ConfigError getError() const {
+			std::lock_guard<std::mutex> lock(mutex);
+			return error;
 		}
 
-	protected:
-		//< Read function implementation
-		virtual void read() override {
-			if (fileExists(path)) {
-				file.open(path, std::ios::in);
-				if (!file.is_open()) {
-					errorCode = ConfigError::FILE_OPEN_ERROR;
-					return;
-				}
-				std::string line;
-				while (!file.eof()) {
-					std::getline(file, line);
-					if (isComment(line)) {
-						appendLine(ConfigType::CONFIG_COMMENT, trim_copy(line));
-					}
-					else if (isEmptyLine(line)) {
-						appendLine(ConfigType::CONFIG_EMPTY_LINE, trim_copy(line));
-					}
-					else if (isValue(line)) {
-						StringVector pare = extractValue(line);
-						if (static_cast<int> (pare.size()) >= 2) {
-							appendLine(ConfigType::CONFIG_VALUE, pare[0]);
-							insert(pare[0], pare[1]);
-						}
-					}
-					line.clear();
-				}
-				file.close();
-				file.clear();
-			}
-			else {
-				errorCode = ConfigError::FILE_NOT_FOUND;
-			}
-		}
+		std::size_t writes() const { return writeCount; } //< Number of files written, lower than the number of saves when bursts were coalesced.
 
-		//< Write function implementation
-		virtual void write() override {
-			if (!path.empty()) {
-				file.open(path, std::ios::out | std::ios::trunc);
-				if (file.is_open()) {
-					for (auto& line : lines) {
-						if (line.type == ConfigType::CONFIG_EMPTY_LINE || line.type == ConfigType::CONFIG_COMMENT) {
-							file << line.content << std::endl;
-						}
-						else if (line.type == ConfigType::CONFIG_VALUE) {
-							file << line.content << " = " << dict[line.content] << std::endl;
-						}
-					}
-					file.close();
+	private:
+		/**
+		 * @brief Writer thread, writes the latest text once its debounce window has passed, or right away when flushing or stopping.
+		 */
+		void run() {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true) {
+				wake.wait(lock, [this] { return pending || stopping; });
+				while (pending && !stopping && flushing == 0 && std::chrono::steady_clock::now() < deadline) {
+					wake.wait_until(lock, deadline);
 				}
-				else {
-					errorCode = ConfigError::FILE_OPEN_ERROR;
+				if (!pending) {
+					break;
 				}
+				std::string path = std::move(pendingPath);
+				std::string text = std::move(pendingText);
+				pending = false;
+				writing = true;
+				lock.unlock();
+				ConfigError result = path.empty() ? ConfigError::NO_ERROR : writeFileBuffer(path, text);
+				lock.lock();
+				writing = false;
+				error = result;
+				writeCount++;
+				done.notify_all();
 			}
 		}
 
-		//< Erase function implementation
-		virtual void erase() override {
-			clear();
-		}
+		Parser& parser;
+		std::chrono::milliseconds debounce;
+		std::thread writer;
+		mutable std::mutex mutex;
+		std::condition_variable wake; //< Signals the writer: a save, a flush or stopping.
+		std::condition_variable done; //< Signals flush(): a write finished.
+		std::string pendingPath;
+		std::string pendingText;
+		std::chrono::steady_clock::time_point deadline; //< End of the debounce window of the pending text.
+		bool pending;
+		bool writing;
+		bool stopping;
+		unsigned flushing; //< Number of threads waiting in flush().
+		ConfigError error;
+		std::atomic<std::size_t> writeCount;
 	};
 
-
 	/**
-	* @class CfgParser class
- * @brief CFG file type  Parser, inherits from Parser class.
- * Provides functionality for  and removing sections. Each section is a ConfigSection class which provides acces to it's values.
- * It is also possibel to loop through class sections as with values.
- */
-	class CfgParser : public Parser {
-	private:
-		StringVector keys;
-		SectionMap _sections;
-
+	* @class ConfigWriter class
+	* @brief Forward only writer generating a config file without building a document, base of IniWriter and CfgWriter.
+	*
+	* Lines are formatted as the parsers write them into a buffer, which is written to the file whenever it holds bufferSize bytes,
+	* so memory use does not grow with the file. The file is written next to the target and renamed over it by close(), readers only
+	* ever see the previous file or the complete new one. After an error every call is ignored, close() reports the first error and leaves the target untouched.
+	*/
+	class ConfigWriter {
 	public:
+		ConfigWriter(const ConfigWriter&) = delete;
+		ConfigWriter& operator=(const ConfigWriter&) = delete;
+		virtual ~ConfigWriter() { discard(); } //< Removes a file that was not closed, its target is left untouched.
+
 		/**
-		 * @brief Constructor.
-		 * @param _path Path to the configuration file.
+		 * @brief Completes the current file, if any, and starts writing a new one.
+		 * @param filePath Path of the file to replace once the writer is closed.
 		 */
-		CfgParser(std::string _path = "") : Parser(_path) {
-			readFile();
+		ConfigError open(const std::string& filePath) {
+			close();
+			errorCode = ConfigError::NO_ERROR;
+			target = replacementTarget(filePath);
+			temp = temporaryPath(target);
+			handle = createFile(temp.string());
+			if (handle < 0) {
+				errorCode = ConfigError::FILE_OPEN_ERROR;
+			}
+			lastEmpty = true;
+			return errorCode;
 		}
 
 		/**
-		 * @brief Destructor.
+		 * @brief Writes a key and its value, formatted as ConfigValue formats it.
 		 */
-		~CfgParser() {
-			clear();
-			erase();
+		template<typename value_type>
+		void writeKey(std::string_view key, const value_type& value) {
+			if (!isWritable()) {
+				return;
+			}
+			buffer += key;
+			buffer += " = ";
+			if constexpr (std::is_convertible<const value_type&, std::string_view>::value) {
+				buffer += std::string_view(value);
+			}
+			else {
+				ConfigValue(value).appendTo(buffer);
+			}
+			endLine(false);
 		}
 
 		/**
-		 * @brief Adds a new section.
-		 * @param sectionName Name of the section to add.
+		 * @brief Writes a comment line, the comment character is added in front of text.
 		 */
-		void addSection(std::string sectionName) {
-			if (!_sections.contains(sectionName)) {
-				keys.push_back(sectionName);
-				appendLine(ConfigType::CONFIG_SECTION, sectionName);
-				_sections[sectionName] = ConfigSection();
+		void comment(std::string_view text) {
+			if (isWritable()) {
+				buffer += "# ";
+				buffer += text;
+				endLine(false);
 			}
 		}
 
 		/**
-		 * @brief Removes a section.
-		 * @param sectionName Name of the section to remove.
+		 * @brief Writes an empty line.
 		 */
-		void removeSection(const std::string& sectionName) {
-			if (_sections.contains(sectionName)) {
-				removeElement<std::string>(keys, sectionName);
-				removeLine(sectionName);
-				_sections.erase(sectionName);
+		void emptyLine() {
+			if (isWritable()) {
+				endLine(true);
 			}
 		}
 
 		/**
-		 * @brief Retrieves a section.
-		 * @param sectionName Name of the section to retrieve.
-		 * @return Reference to the ConfigSection.
-		 * @throw std::out_of_range if section not found.
+		 * @brief Writes the buffered lines, flushes the file to the disk and renames it over the target.
+		 * @return The first error met since the file was opened.
 		 */
-		ConfigSection& section(const std::string& sectionName) {
-			if (_sections.contains(sectionName)) {
-				return _sections[sectionName];
+		ConfigError close() {
+			if (handle < 0) {
+				return errorCode;
 			}
-			else {
-				throw std::out_of_range("Section not found: " + sectionName);
+			bool success = (errorCode == ConfigError::NO_ERROR) && writeHandle(handle, buffer);
+			success = closeHandle(handle, success) && success;
+			handle = -1;
+			buffer.clear();
+			if (!success) {
+				std::error_code error;
+				std::filesystem::remove(temp, error);
+				if (errorCode == ConfigError::NO_ERROR) {
+					errorCode = ConfigError::FILE_WRITE_ERROR;
+				}
+				return errorCode;
 			}
+			errorCode = replaceFile(temp, target);
+			return errorCode;
 		}
 
 		/**
-		 * @brief Gets all section names.
-		 * @return Vector of section names.
+		 * @brief Abandons the current file without replacing the target.
 		 */
-		const StringVector& sections() { return keys; }
+		void discard() {
+			if (handle < 0) {
+				return;
+			}
+			closeHandle(handle, false);
+			handle = -1;
+			buffer.clear();
+			std::error_code error;
+			std::filesystem::remove(temp, error);
+		}
+
+		ConfigError getError() const { return errorCode; } //< Gets the first error met since the file was opened.
+		bool isOpen() const { return handle >= 0; } //< Checks if a file is being written.
 
+	protected:
 		/**
-		 * @brief Clears all sections and parser data.
+		 * @brief Constructor, opens filePath unless it is empty.
+		 * @param bufferSize Bytes buffered before they are written to the file.
 		 */
-		void clear() {
-			keys.clear();
-			_sections.clear();
-			Parser::erase();
+		ConfigWriter(const std::string& filePath, std::size_t _bufferSize) :
+			bufferSize(std::max<std::size_t>(_bufferSize, 1)), handle(-1), errorCode(ConfigError::NO_ERROR), lastEmpty(true) {
+			buffer.reserve(bufferSize);
+			if (!filePath.empty()) {
+				open(filePath);
+			}
 		}
 
-		ConfigSection& operator[](const std::string& sectionName) { return section(sectionName); }
-
-		KeysIter begin() { return keys.begin(); }
-		KeysIter end() { return keys.end(); }
-		ConstKeysIter cbegin() { return keys.cbegin(); }
-		ConstKeysIter cend() { return keys.cend(); }
+		bool isWritable() const { return handle >= 0 && errorCode == ConfigError::NO_ERROR; } //< Checks if lines are accepted.
 
-	protected:
 		/**
-		 * @brief Reads the configuration file.
+		 * @brief Ends the current line and writes the buffer once it is full.
 		 */
-		virtual void read() override {
-			if (fileExists(path)) {
-				file.open(path, std::ios::in);
-				if (!file.is_open()) {
-					errorCode = ConfigError::FILE_OPEN_ERROR;
-					return;
+		void endLine(bool empty) {
+			buffer += '\n';
+			lastEmpty = empty;
+			if (buffer.size() >= bufferSize) {
+				if (!writeHandle(handle, buffer)) {
+					errorCode = ConfigError::FILE_WRITE_ERROR;
 				}
-				std::string line;
-				while (!file.eof()) {
-					std::getline(file, line);
-					if (isComment(line)) {
-						appendLine(ConfigType::CONFIG_COMMENT, trim_copy(line));
-					}
-					else if (isEmptyLine(line)) {
-						appendLine(ConfigType::CONFIG_EMPTY_LINE, trim_copy(line));
-					}
-					else if (isSection(line)) {
-						std::string section_name = extractSection(line);
-						appendLine(ConfigType::CONFIG_SECTION, line);
-						addSection(section_name);
-						bool section_end = false;
-						while (!section_end && !file.eof()) {
-							line.clear();
-							std::getline(file, line);
-							if (isEmptyLine(line)) {
-								section_end = true;
-							}
-							else if (isValue(line)) {
-								auto value = extractValue(line);
-								if (static_cast<int>(value.size()) >= 2) {
-									_sections[section_name][value[0]] = value[1];
-								}
-							}
-						}
-					}
-					line.clear();
-				}
-				file.close();
-				file.clear();
-			}
-			else {
-				errorCode = ConfigError::FILE_NOT_FOUND;
+				buffer.clear();
 			}
 		}
 
+		std::string buffer;
+		std::size_t bufferSize;
+		std::filesystem::path target;
+		std::filesystem::path temp;
+		int handle;
+		ConfigError errorCode;
+		bool lastEmpty; //< The last line written was empty, or nothing was written yet.
+	};
+
+	/**
+	* @class IniWriter class
+	* @brief Forward only INI file writer, see ConfigWriter.
+	*/
+	class IniWriter : public ConfigWriter {
+	public:
+		/**
+		 * @brief Constructor.
+		 * @param filePath File to write, open() starts one later when empty.
+		 * @param bufferSize Bytes buffered before they are written to the file.
+		 */
+		IniWriter(const std::string& filePath = "", std::size_t bufferSize = 64 * 1024) :
+			ConfigWriter(filePath, bufferSize) {}
+	};
+
+	/**
+	* @class CfgWriter class
+	* @brief Forward only CFG file writer, see ConfigWriter. Keys are written to the section begun last.
+	*/
+	class CfgWriter : public ConfigWriter {
+	public:
+		/**
+		 * @brief Constructor.
+		 * @param filePath File to write, open() starts one later when empty.
+		 * @param bufferSize Bytes buffered before they are written to the file.
+		 */
+		CfgWriter(const std::string& filePath = "", std::size_t bufferSize = 64 * 1024) :
+			ConfigWriter(filePath, bufferSize), inSection(false) {}
+
+		/**
+		 * @brief Completes the current file, if any, and starts writing a new one.
+		 */
+		ConfigError open(const std::string& filePath) {
+			inSection = false;
+			return ConfigWriter::open(filePath);
+		}
+
 		/**
-		 * @brief Writes the configuration to file.
+		 * @brief Writes a section header, separated from the previous lines by an empty line as CfgParser::addSection() does.
 		 */
-		virtual void write() override {
-			if (!path.empty()) {
-				file.open(path, std::ios::out | std::ios::trunc);
-				if (file.is_open()) {
-					for (auto& line : lines) {
-						if (line.type == ConfigType::CONFIG_EMPTY_LINE || line.type == ConfigType::CONFIG_COMMENT) {
-							file << line.content << std::endl;
-						}
-						else if (line.type == ConfigType::CONFIG_SECTION) {
-							file << "[" << line.content << "]" << std::endl;
-							ConfigSection& section_ = (*this)[line.content];
-							for (auto& value : section_) {
-								file << value << " = " << section_[value] << std::endl;
-							}
-							file << "\n" << std::endl;
-						}
-					}
-					file.close();
-					file.clear();
-				}
-				else {
-					errorCode = ConfigError::FILE_OPEN_ERROR;
-				}
+		void beginSection(std::string_view sectionName) {
+			if (!isWritable()) {
+				return;
+			}
+			if (!lastEmpty) {
+				endLine(true);
 			}
+			buffer += '[';
+			buffer += sectionName;
+			buffer += ']';
+			endLine(false);
+			inSection = true;
 		}
 
 		/**
-		 * @brief Erases all data.
+		 * @brief Writes a key and its value to the current section.
+		 * A key written before any section would not be read back, it sets FILE_FORMAT_ERROR.
 		 */
-		virtual void erase() override {
-			clear();
+		template<typename value_type>
+		void writeKey(std::string_view key, const value_type& value) {
+			if (!inSection) {
+				if (isWritable()) {
+					errorCode = ConfigError::FILE_FORMAT_ERROR;
+				}
+				return;
+			}
+			ConfigWriter::writeKey(key, value);
 		}
+
+	private:
+		bool inSection;
 	};
 } //Namespace ConfigParser 
\ No newline at end of file